@@ -34,6 +34,22 @@ static const int SOC_ADC_RTC_MAX_BITWIDTH = 12;
 
 static const int ADC_MAX = (1 << SOC_ADC_RTC_MAX_BITWIDTH) - 1;    // 4095 (12 bit) or 8191 (13 bit)
 static const int ADC_HALF = (1 << SOC_ADC_RTC_MAX_BITWIDTH) >> 1;  // 2048 (12 bit) or 4096 (13 bit)
+
+// Bytes buffered by the continuous mode driver, enough for a few loop() iterations at high sample rates
+static const uint32_t ADC_CONTINUOUS_BUFFER_SIZE = 4096;
+// Number of samples converted and handed to the consumer at once
+static const size_t ADC_CONTINUOUS_BLOCK_SIZE = 64;
+#if defined(USE_ESP32_VARIANT_ESP32) || defined(USE_ESP32_VARIANT_ESP32S2)
+static const bool ADC_CONTINUOUS_CONV_LIMIT_EN = true;
+static const adc_digi_output_format_t ADC_CONTINUOUS_FORMAT = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+#else
+static const bool ADC_CONTINUOUS_CONV_LIMIT_EN = false;
+static const adc_digi_output_format_t ADC_CONTINUOUS_FORMAT = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+#endif
+#endif
+
+#ifdef USE_ESP32
+ADCSensor *ADCSensor::continuous_owner_ = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 #endif
 
 #ifdef USE_RP2040
@@ -128,6 +144,13 @@ void ADCSensor::dump_config() {
 
 float ADCSensor::get_setup_priority() const { return setup_priority::DATA; }
 void ADCSensor::update() {
+#ifdef USE_ESP32
+  // ADC1 is owned by the continuous mode driver while a consumer is sampling, skip until it's released
+  if (continuous_owner_ != nullptr) {
+    ESP_LOGV(TAG, "'%s': ADC1 is sampled continuously, skipping update", this->get_name().c_str());
+    return;
+  }
+#endif
   float value_v = this->sample();
   ESP_LOGV(TAG, "'%s': Got voltage=%.4fV", this->get_name().c_str(), value_v);
   this->publish_state(value_v);
@@ -149,6 +172,9 @@ float ADCSensor::sample() {
 
 #ifdef USE_ESP32
 float ADCSensor::sample() {
+  // ADC1 is owned by the continuous mode driver while a consumer is sampling
+  if (continuous_owner_ != nullptr)
+    return NAN;
   if (!autorange_) {
     int raw = adc1_get_raw(channel_);
     if (raw == -1) {
@@ -198,6 +224,97 @@ float ADCSensor::sample() {
   uint32_t mv_scaled = (mv11 * c11) + (mv6 * c6) + (mv2 * c2) + (mv0 * c0);
   return mv_scaled / (float) (csum * 1000U);
 }
+
+bool ADCSensor::start_continuous(uint32_t sample_rate, voltage_sampler::SampleBlockCallback &&callback) {
+  if (continuous_owner_ != nullptr || this->autorange_)
+    return false;
+
+  adc_digi_init_config_t init_config{};
+  init_config.max_store_buf_size = ADC_CONTINUOUS_BUFFER_SIZE;
+  init_config.conv_num_each_intr = ADC_CONTINUOUS_BLOCK_SIZE * sizeof(adc_digi_output_data_t);
+  init_config.adc1_chan_mask = BIT(this->channel_);
+  init_config.adc2_chan_mask = 0;
+  esp_err_t err = adc_digi_initialize(&init_config);
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "'%s': Initializing continuous mode failed: %s", this->get_name().c_str(), esp_err_to_name(err));
+    return false;
+  }
+
+  adc_digi_pattern_config_t pattern{};
+  pattern.atten = this->attenuation_;
+  pattern.channel = this->channel_;
+  pattern.unit = 0;  // ADC1
+  pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+  adc_digi_configuration_t config{};
+  config.conv_limit_en = ADC_CONTINUOUS_CONV_LIMIT_EN;
+  config.conv_limit_num = 250;
+  config.pattern_num = 1;
+  config.adc_pattern = &pattern;
+  config.sample_freq_hz = clamp<uint32_t>(sample_rate, SOC_ADC_SAMPLE_FREQ_THRES_LOW, SOC_ADC_SAMPLE_FREQ_THRES_HIGH);
+  config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  config.format = ADC_CONTINUOUS_FORMAT;
+  err = adc_digi_controller_configure(&config);
+  if (err == ESP_OK)
+    err = adc_digi_start();
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "'%s': Starting continuous mode failed: %s", this->get_name().c_str(), esp_err_to_name(err));
+    adc_digi_deinitialize();
+    return false;
+  }
+
+  ESP_LOGV(TAG, "'%s': Sampling continuously at %u Hz", this->get_name().c_str(), config.sample_freq_hz);
+  this->continuous_callback_ = std::move(callback);
+  continuous_owner_ = this;
+  return true;
+}
+
+void ADCSensor::stop_continuous() {
+  if (continuous_owner_ != this)
+    return;
+  adc_digi_stop();
+  adc_digi_deinitialize();
+  continuous_owner_ = nullptr;
+  this->continuous_callback_ = nullptr;
+
+  // The continuous mode driver reconfigures ADC1, restore the one-shot configuration
+  adc1_config_width(ADC_WIDTH_MAX_SOC_BITS);
+  adc1_config_channel_atten(this->channel_, this->attenuation_);
+}
+
+void ADCSensor::loop() {
+  if (continuous_owner_ != this)
+    return;
+
+  adc_digi_output_data_t data[ADC_CONTINUOUS_BLOCK_SIZE];
+  float samples[ADC_CONTINUOUS_BLOCK_SIZE];
+  const auto *cal = &this->cal_characteristics_[(int) this->attenuation_];
+  // Drain what was buffered since the last iteration, bounded so a consumer that can't keep up doesn't stall the loop
+  for (size_t i = 0; i < ADC_CONTINUOUS_BUFFER_SIZE / sizeof(data); i++) {
+    uint32_t length = 0;
+    esp_err_t err = adc_digi_read_bytes(reinterpret_cast<uint8_t *>(data), sizeof(data), &length, 0);
+    if (err == ESP_ERR_INVALID_STATE) {
+      ESP_LOGV(TAG, "'%s': Continuous mode buffer overflowed, samples were lost", this->get_name().c_str());
+    } else if (err != ESP_OK) {
+      break;
+    }
+    size_t count = length / sizeof(adc_digi_output_data_t);
+    if (count == 0)
+      break;
+
+    for (size_t j = 0; j < count; j++) {
+#if defined(USE_ESP32_VARIANT_ESP32) || defined(USE_ESP32_VARIANT_ESP32S2)
+      uint32_t raw = data[j].type1.data;
+#else
+      uint32_t raw = data[j].type2.data;
+#endif
+      // The calibration is for the one-shot bit width, which may be wider than the continuous mode one
+      raw <<= SOC_ADC_RTC_MAX_BITWIDTH - SOC_ADC_DIGI_MAX_BITWIDTH;
+      samples[j] = this->output_raw_ ? raw : esp_adc_cal_raw_to_voltage(raw, cal) / 1000.0f;
+    }
+    this->continuous_callback_(samples, count);
+  }
+}
 #endif  // USE_ESP32
 
 #ifdef USE_RP2040
@@ -34,6 +34,16 @@ class ADCSensor : public sensor::Sensor, public PollingComponent, public voltage
   void set_output_raw(bool output_raw) { output_raw_ = output_raw; }
   float sample() override;
 
+#ifdef USE_ESP32
+  /// Hand the samples buffered by the continuous mode driver to the consumer.
+  void loop() override;
+  bool start_continuous(uint32_t sample_rate, voltage_sampler::SampleBlockCallback &&callback) override;
+  void stop_continuous() override;
+  bool supports_continuous() const override { return !this->autorange_; }
+  /// The continuous mode driver owns all of ADC1, so this is true for every ADC1 sensor while any of them samples.
+  bool is_continuous() const override { return continuous_owner_ != nullptr; }
+#endif
+
 #ifdef USE_ESP8266
   std::string unique_id() override;
 #endif
@@ -55,6 +65,9 @@ class ADCSensor : public sensor::Sensor, public PollingComponent, public voltage
   adc1_channel_t channel_{};
   bool autorange_{false};
   esp_adc_cal_characteristics_t cal_characteristics_[(int) ADC_ATTEN_MAX] = {};
+  voltage_sampler::SampleBlockCallback continuous_callback_;
+  /// The sensor sampling ADC1 continuously, nullptr if none.
+  static ADCSensor *continuous_owner_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 #endif
 };
 
@@ -3,7 +3,7 @@ import logging
 from esphome import core
 from esphome.components import display, font
 import esphome.components.image as espImage
-from esphome.components.image import CONF_USE_TRANSPARENCY
+from esphome.components.image import CONF_COMPRESSION, CONF_USE_TRANSPARENCY
 import esphome.config_validation as cv
 import esphome.codegen as cg
 from esphome.const import (
@@ -44,6 +44,8 @@ def validate_cross_dependencies(config):
     if is_transparent_type and not config[CONF_USE_TRANSPARENCY]:
         raise cv.Invalid(f"Image type {image_type} must always be transparent.")
 
+    espImage.validate_compression(config)
+
     return config
 
 
@@ -59,6 +61,9 @@ ANIMATION_SCHEMA = cv.Schema(
             # Not setting default here on purpose; the default depends on the image type,
             # and thus will be set in the "validate_cross_dependencies" validator.
             cv.Optional(CONF_USE_TRANSPARENCY): cv.boolean,
+            cv.Optional(CONF_COMPRESSION, default="NONE"): cv.enum(
+                espImage.IMAGE_COMPRESSION, upper=True
+            ),
             cv.Optional(CONF_LOOP): cv.All(
                 {
                     cv.Optional(CONF_START_FRAME, default=0): cv.positive_int,
@@ -234,6 +239,16 @@ async def to_code(config):
             f"Animation f{config[CONF_ID]} has not supported type {config[CONF_TYPE]}."
         )
 
+    compression = config[CONF_COMPRESSION]
+    if compression == "RLE":
+        raw_size = len(data)
+        data = espImage.rle_encode(
+            data, width, height, frames, espImage.BYTES_PER_PIXEL[config[CONF_TYPE]]
+        )
+        _LOGGER.debug(
+            "%s compressed from %d to %d bytes", config[CONF_ID], raw_size, len(data)
+        )
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
     var = cg.new_Pvariable(
@@ -245,6 +260,8 @@ async def to_code(config):
         espImage.IMAGE_TYPE[config[CONF_TYPE]],
     )
     cg.add(var.set_transparency(transparent))
+    if compression != "NONE":
+        cg.add(var.set_compression(espImage.IMAGE_COMPRESSION[compression]))
     if CONF_LOOP in config:
         start = config[CONF_LOOP][CONF_START_FRAME]
         end = config[CONF_LOOP].get(CONF_END_FRAME, frames)
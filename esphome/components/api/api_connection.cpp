@@ -429,6 +429,8 @@ bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
   resp.key = sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !sensor->has_state();
+  if (sensor->has_state())
+    resp.state_age = millis() - sensor->get_state_timestamp();
   return this->send_sensor_state_response(resp);
 }
 bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
@@ -490,13 +492,13 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
 #endif
 
 #ifdef USE_TEXT_SENSOR
-bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state) {
+bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, const std::string &state) {
   if (!this->state_subscription_)
     return false;
 
   TextSensorStateResponse resp{};
   resp.key = text_sensor->get_object_id_hash();
-  resp.state = std::move(state);
+  resp.state = state;
   resp.missing_state = !text_sensor->has_state();
   return this->send_text_sensor_state_response(resp);
 }
@@ -656,13 +658,13 @@ void APIConnection::number_command(const NumberCommandRequest &msg) {
 #endif
 
 #ifdef USE_SELECT
-bool APIConnection::send_select_state(select::Select *select, std::string state) {
+bool APIConnection::send_select_state(select::Select *select, const std::string &state) {
   if (!this->state_subscription_)
     return false;
 
   SelectStateResponse resp{};
   resp.key = select->get_object_id_hash();
-  resp.state = std::move(state);
+  resp.state = state;
   resp.missing_state = !select->has_state();
   return this->send_select_state_response(resp);
 }
@@ -934,6 +936,10 @@ void APIConnection::on_voice_assistant_event_response(const VoiceAssistantEventR
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
   if (this->log_subscription_ < level)
     return false;
+#ifdef USE_LOGGER_BINARY
+  if (this->log_binary_)
+    return false;
+#endif
 
   // Send raw so that we don't copy too much
   auto buffer = this->create_buffer();
@@ -944,6 +950,32 @@ bool APIConnection::send_log_message(int level, const char *tag, const char *lin
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
+#ifdef USE_LOGGER_BINARY
+bool APIConnection::send_binary_log_message(const logger::BinaryLogMessage &msg) {
+  if (!this->log_binary_ || this->log_subscription_ < msg.level)
+    return false;
+
+  auto buffer = this->create_buffer();
+  // LogLevel level = 1;
+  buffer.encode_uint32(1, static_cast<uint32_t>(msg.level));
+  const char *args = reinterpret_cast<const char *>(msg.args);
+  if (msg.format_id == 0) {
+    // string message = 3;
+    buffer.encode_string(3, args, msg.args_len);
+  } else {
+    // uint32 format_id = 5;
+    buffer.encode_uint32(5, msg.format_id);
+    // uint32 tag_id = 6;
+    buffer.encode_uint32(6, msg.tag_id);
+    // uint32 line = 7;
+    buffer.encode_uint32(7, static_cast<uint32_t>(msg.line));
+    // bytes args = 8;
+    buffer.encode_string(8, args, msg.args_len);
+  }
+  // SubscribeLogsResponse - 29
+  return this->send_buffer(buffer, 29);
+}
+#endif
 
 HelloResponse APIConnection::hello(const HelloRequest &msg) {
   this->client_info_ = msg.client_info + " (" + this->helper_->getpeername() + ")";
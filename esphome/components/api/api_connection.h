@@ -8,6 +8,10 @@
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 
+#ifdef USE_LOGGER_BINARY
+#include "esphome/components/logger/logger.h"
+#endif
+
 #include <vector>
 
 namespace esphome {
@@ -54,7 +58,7 @@ class APIConnection : public APIServerConnection {
   void switch_command(const SwitchCommandRequest &msg) override;
 #endif
 #ifdef USE_TEXT_SENSOR
-  bool send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state);
+  bool send_text_sensor_state(text_sensor::TextSensor *text_sensor, const std::string &state);
   bool send_text_sensor_info(text_sensor::TextSensor *text_sensor);
 #endif
 #ifdef USE_ESP32_CAMERA
@@ -73,7 +77,7 @@ class APIConnection : public APIServerConnection {
   void number_command(const NumberCommandRequest &msg) override;
 #endif
 #ifdef USE_SELECT
-  bool send_select_state(select::Select *select, std::string state);
+  bool send_select_state(select::Select *select, const std::string &state);
   bool send_select_info(select::Select *select);
   void select_command(const SelectCommandRequest &msg) override;
 #endif
@@ -92,6 +96,9 @@ class APIConnection : public APIServerConnection {
   void media_player_command(const MediaPlayerCommandRequest &msg) override;
 #endif
   bool send_log_message(int level, const char *tag, const char *line);
+#ifdef USE_LOGGER_BINARY
+  bool send_binary_log_message(const logger::BinaryLogMessage &msg);
+#endif
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call) {
     if (!this->service_call_subscription_)
       return;
@@ -150,6 +157,10 @@ class APIConnection : public APIServerConnection {
   }
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
+#ifdef USE_LOGGER_BINARY
+    this->log_binary_ = msg.binary;
+    this->parent_->add_log_callback(msg.binary);
+#endif
     if (msg.dump_config)
       App.schedule_dump_config();
   }
@@ -204,6 +215,9 @@ class APIConnection : public APIServerConnection {
 
   bool state_subscription_{false};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
+#ifdef USE_LOGGER_BINARY
+  bool log_binary_{false};
+#endif
   uint32_t last_traffic_;
   bool sent_ping_{false};
   bool service_call_subscription_{false};
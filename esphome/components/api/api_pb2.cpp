@@ -2308,6 +2308,10 @@ bool SensorStateResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
       this->missing_state = value.as_bool();
       return true;
     }
+    case 4: {
+      this->state_age = value.as_uint32();
+      return true;
+    }
     default:
       return false;
   }
@@ -2330,6 +2334,7 @@ void SensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
+  buffer.encode_uint32(4, this->state_age);
 }
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SensorStateResponse::dump_to(std::string &out) const {
@@ -2348,6 +2353,11 @@ void SensorStateResponse::dump_to(std::string &out) const {
   out.append("  missing_state: ");
   out.append(YESNO(this->missing_state));
   out.append("\n");
+
+  out.append("  state_age: ");
+  sprintf(buffer, "%u", this->state_age);
+  out.append(buffer);
+  out.append("\n");
   out.append("}");
 }
 #endif
@@ -2691,6 +2701,10 @@ bool SubscribeLogsRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
       this->dump_config = value.as_bool();
       return true;
     }
+    case 3: {
+      this->binary = value.as_bool();
+      return true;
+    }
     default:
       return false;
   }
@@ -2698,6 +2712,7 @@ bool SubscribeLogsRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 void SubscribeLogsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_bool(2, this->dump_config);
+  buffer.encode_bool(3, this->binary);
 }
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsRequest::dump_to(std::string &out) const {
@@ -2710,6 +2725,10 @@ void SubscribeLogsRequest::dump_to(std::string &out) const {
   out.append("  dump_config: ");
   out.append(YESNO(this->dump_config));
   out.append("\n");
+
+  out.append("  binary: ");
+  out.append(YESNO(this->binary));
+  out.append("\n");
   out.append("}");
 }
 #endif
@@ -2723,6 +2742,18 @@ bool SubscribeLogsResponse::decode_varint(uint32_t field_id, ProtoVarInt value)
       this->send_failed = value.as_bool();
       return true;
     }
+    case 5: {
+      this->format_id = value.as_uint32();
+      return true;
+    }
+    case 6: {
+      this->tag_id = value.as_uint32();
+      return true;
+    }
+    case 7: {
+      this->line = value.as_uint32();
+      return true;
+    }
     default:
       return false;
   }
@@ -2733,6 +2764,10 @@ bool SubscribeLogsResponse::decode_length(uint32_t field_id, ProtoLengthDelimite
       this->message = value.as_string();
       return true;
     }
+    case 8: {
+      this->args = value.as_string();
+      return true;
+    }
     default:
       return false;
   }
@@ -2741,6 +2776,10 @@ void SubscribeLogsResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_string(3, this->message);
   buffer.encode_bool(4, this->send_failed);
+  buffer.encode_uint32(5, this->format_id);
+  buffer.encode_uint32(6, this->tag_id);
+  buffer.encode_uint32(7, this->line);
+  buffer.encode_string(8, this->args);
 }
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsResponse::dump_to(std::string &out) const {
@@ -2757,6 +2796,25 @@ void SubscribeLogsResponse::dump_to(std::string &out) const {
   out.append("  send_failed: ");
   out.append(YESNO(this->send_failed));
   out.append("\n");
+
+  out.append("  format_id: ");
+  sprintf(buffer, "%u", this->format_id);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  tag_id: ");
+  sprintf(buffer, "%u", this->tag_id);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  line: ");
+  sprintf(buffer, "%u", this->line);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  args: ");
+  out.append("'").append(this->args).append("'");
+  out.append("\n");
   out.append("}");
 }
 #endif
@@ -66,15 +66,8 @@ void APIServer::setup() {
     return;
   }
 
-#ifdef USE_LOGGER
-  if (logger::global_logger != nullptr) {
-    logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      for (auto &c : this->clients_) {
-        if (!c->remove_)
-          c->send_log_message(level, tag, message);
-      }
-    });
-  }
+#if defined(USE_LOGGER) && !defined(USE_LOGGER_BINARY)
+  this->add_log_callback(false);
 #endif
 
   this->last_connected_ = millis();
@@ -173,6 +166,36 @@ bool APIServer::check_password(const std::string &password) const {
   return result == 0;
 }
 void APIServer::handle_disconnect(APIConnection *conn) {}
+#ifdef USE_LOGGER
+void APIServer::add_log_callback(bool binary) {
+  if (logger::global_logger == nullptr)
+    return;
+#ifdef USE_LOGGER_BINARY
+  // Registered on demand, as with a text listener the logger formats every message on the device.
+  if (binary) {
+    if (this->binary_log_callback_added_)
+      return;
+    this->binary_log_callback_added_ = true;
+    logger::global_logger->add_on_binary_log_callback([this](const logger::BinaryLogMessage &msg) {
+      for (auto &c : this->clients_) {
+        if (!c->remove_)
+          c->send_binary_log_message(msg);
+      }
+    });
+    return;
+  }
+#endif
+  if (this->log_callback_added_)
+    return;
+  this->log_callback_added_ = true;
+  logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
+    for (auto &c : this->clients_) {
+      if (!c->remove_)
+        c->send_log_message(level, tag, message);
+    }
+  });
+}
+#endif
 #ifdef USE_BINARY_SENSOR
 void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
   if (obj->is_internal())
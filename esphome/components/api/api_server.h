@@ -38,6 +38,10 @@ class APIServer : public Component, public Controller {
 #endif  // USE_API_NOISE
 
   void handle_disconnect(APIConnection *conn);
+#ifdef USE_LOGGER
+  /// Forward log messages (in the binary format if binary is true) to the subscribed clients, if not done already.
+  void add_log_callback(bool binary);
+#endif
 #ifdef USE_BINARY_SENSOR
   void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
 #endif
@@ -107,6 +111,12 @@ class APIServer : public Component, public Controller {
   std::string password_;
   std::vector<HomeAssistantStateSubscription> state_subs_;
   std::vector<UserServiceDescriptor *> user_services_;
+#ifdef USE_LOGGER
+  bool log_callback_added_{false};
+#endif
+#ifdef USE_LOGGER_BINARY
+  bool binary_log_callback_added_{false};
+#endif
 
 #ifdef USE_API_NOISE
   std::shared_ptr<APINoiseContext> noise_ctx_ = std::make_shared<APINoiseContext>();
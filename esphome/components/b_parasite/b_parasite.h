@@ -15,6 +15,7 @@ class BParasite : public Component, public esp32_ble_tracker::ESPBTDeviceListene
   void set_bindkey(const std::string &bindkey);
 
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
+  std::vector<uint64_t> get_address_filter() const override { return {this->address_}; }
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
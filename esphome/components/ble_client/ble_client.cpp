@@ -15,6 +15,10 @@ static const char *const TAG = "ble_client";
 void BLEClient::setup() {
   BLEClientBase::setup();
   this->enabled = true;
+  // The client stays with one device, so its database survives a reboot without wearing the flash. Register the
+  // address now to load the database saved before, databases discovered later are saved as they come in.
+  this->set_persist_gatt_database(true);
+  esp32_ble_client::global_gatt_cache.persist(this->address_);
 }
 
 void BLEClient::loop() {
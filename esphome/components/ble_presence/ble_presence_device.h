@@ -50,6 +50,16 @@ class BLEPresenceDevice : public binary_sensor::BinarySensorInitiallyOff,
       this->publish_state(false);
     this->found_ = false;
   }
+  std::vector<uint64_t> get_address_filter() const override {
+    if (this->match_by_ == MATCH_BY_MAC_ADDRESS)
+      return {this->address_};
+    return {};
+  }
+  std::vector<esp32_ble_tracker::ESPBTUUID> get_service_uuid_filter() const override {
+    if (this->match_by_ == MATCH_BY_SERVICE_UUID)
+      return {this->uuid_};
+    return {};
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override {
     if (this->check_minimum_rssi_ && this->minimum_rssi_ <= device.get_rssi()) {
       return false;
@@ -44,6 +44,16 @@ class BLERSSISensor : public sensor::Sensor, public esp32_ble_tracker::ESPBTDevi
       this->publish_state(NAN);
     this->found_ = false;
   }
+  std::vector<uint64_t> get_address_filter() const override {
+    if (this->match_by_ == MATCH_BY_MAC_ADDRESS)
+      return {this->address_};
+    return {};
+  }
+  std::vector<esp32_ble_tracker::ESPBTUUID> get_service_uuid_filter() const override {
+    if (this->match_by_ == MATCH_BY_SERVICE_UUID)
+      return {this->uuid_};
+    return {};
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override {
     switch (this->match_by_) {
       case MATCH_BY_MAC_ADDRESS:
@@ -8,10 +8,15 @@
 
 #include "bluetooth_proxy.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 namespace esphome {
 namespace bluetooth_proxy {
 
 static const char *const TAG = "bluetooth_proxy.connection";
+// Operations whose completion never arrives are dropped from the bookkeeping beyond this
+static const size_t MAX_PENDING_OPERATIONS = 16;
 
 bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                                               esp_ble_gattc_cb_param_t *param) {
@@ -20,6 +25,7 @@ bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_ga
 
   switch (event) {
     case ESP_GATTC_DISCONNECT_EVT: {
+      this->log_operation_stats_();
       this->proxy_->send_device_connection(this->address_, false, 0, param->disconnect.reason);
       this->set_address(0);
       this->proxy_->send_connections_free();
@@ -71,6 +77,7 @@ bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_ga
     case ESP_GATTC_READ_CHAR_EVT: {
       if (param->read.conn_id != this->conn_id_)
         break;
+      this->finish_operation_(param->read.handle);
       if (param->read.status != ESP_GATT_OK) {
         ESP_LOGW(TAG, "[%d] [%s] Error reading char/descriptor at handle 0x%2X, status=%d", this->connection_index_,
                  this->address_str_.c_str(), param->read.handle, param->read.status);
@@ -91,6 +98,7 @@ bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_ga
     case ESP_GATTC_WRITE_DESCR_EVT: {
       if (param->write.conn_id != this->conn_id_)
         break;
+      this->finish_operation_(param->write.handle);
       if (param->write.status != ESP_GATT_OK) {
         ESP_LOGW(TAG, "[%d] [%s] Error writing char/descriptor at handle 0x%2X, status=%d", this->connection_index_,
                  this->address_str_.c_str(), param->write.handle, param->write.status);
@@ -185,6 +193,7 @@ esp_err_t BluetoothConnection::read_characteristic(uint16_t handle) {
              this->address_str_.c_str(), err);
     return err;
   }
+  this->start_operation_(handle);
   return ESP_OK;
 }
 
@@ -205,6 +214,7 @@ esp_err_t BluetoothConnection::write_characteristic(uint16_t handle, const std::
              this->address_str_.c_str(), err);
     return err;
   }
+  this->start_operation_(handle);
   return ESP_OK;
 }
 
@@ -223,6 +233,7 @@ esp_err_t BluetoothConnection::read_descriptor(uint16_t handle) {
              this->address_str_.c_str(), err);
     return err;
   }
+  this->start_operation_(handle);
   return ESP_OK;
 }
 
@@ -243,6 +254,7 @@ esp_err_t BluetoothConnection::write_descriptor(uint16_t handle, const std::stri
              this->address_str_.c_str(), err);
     return err;
   }
+  this->start_operation_(handle);
   return ESP_OK;
 }
 
@@ -275,6 +287,40 @@ esp_err_t BluetoothConnection::notify_characteristic(uint16_t handle, bool enabl
   return ESP_OK;
 }
 
+void BluetoothConnection::start_operation_(uint16_t handle) {
+  if (this->pending_operations_.size() >= MAX_PENDING_OPERATIONS)
+    this->pending_operations_.erase(this->pending_operations_.begin());
+  this->pending_operations_.push_back(PendingOperation{handle, millis()});
+}
+
+void BluetoothConnection::finish_operation_(uint16_t handle) {
+  // Bluedroid completes the operations of a connection in the order they were issued
+  for (auto it = this->pending_operations_.begin(); it != this->pending_operations_.end(); ++it) {
+    if (it->handle != handle)
+      continue;
+    const uint32_t latency = millis() - it->started;
+    this->pending_operations_.erase(it);
+    this->operation_count_++;
+    this->operation_total_ms_ += latency;
+    this->operation_max_ms_ = std::max(this->operation_max_ms_, latency);
+    ESP_LOGV(TAG, "[%d] [%s] GATT operation on handle 0x%2X took %" PRIu32 " ms", this->connection_index_,
+             this->address_str_.c_str(), handle, latency);
+    return;
+  }
+}
+
+void BluetoothConnection::log_operation_stats_() {
+  if (this->operation_count_ != 0) {
+    ESP_LOGD(TAG, "[%d] [%s] %" PRIu32 " GATT operations, average %" PRIu32 " ms, max %" PRIu32 " ms",
+             this->connection_index_, this->address_str_.c_str(), this->operation_count_,
+             this->operation_total_ms_ / this->operation_count_, this->operation_max_ms_);
+  }
+  this->pending_operations_.clear();
+  this->operation_count_ = 0;
+  this->operation_total_ms_ = 0;
+  this->operation_max_ms_ = 0;
+}
+
 }  // namespace bluetooth_proxy
 }  // namespace esphome
 
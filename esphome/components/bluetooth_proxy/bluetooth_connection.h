@@ -4,6 +4,8 @@
 
 #include "esphome/components/esp32_ble_client/ble_client_base.h"
 
+#include <vector>
+
 namespace esphome {
 namespace bluetooth_proxy {
 
@@ -26,6 +28,20 @@ class BluetoothConnection : public esp32_ble_client::BLEClientBase {
   friend class BluetoothProxy;
   bool seen_mtu_or_services_{false};
 
+  /// Remember when a read or write was handed to the stack, to report its latency once it completes.
+  void start_operation_(uint16_t handle);
+  void finish_operation_(uint16_t handle);
+  void log_operation_stats_();
+
+  struct PendingOperation {
+    uint16_t handle;
+    uint32_t started;
+  };
+  std::vector<PendingOperation> pending_operations_;
+  uint32_t operation_count_{0};
+  uint32_t operation_total_ms_{0};
+  uint32_t operation_max_ms_{0};
+
   int16_t send_service_{-2};
   BluetoothProxy *proxy_;
 };
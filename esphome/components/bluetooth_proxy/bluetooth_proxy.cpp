@@ -10,6 +10,8 @@ namespace bluetooth_proxy {
 
 static const char *const TAG = "bluetooth_proxy";
 static const int DONE_SENDING_SERVICES = -2;
+// Upper bound of an encoded BluetoothLERawAdvertisement, including its field key and length.
+static const size_t MAX_RAW_ADVERTISEMENT_SIZE = 80;
 
 std::vector<uint64_t> get_128bit_uuid_vec(esp_bt_uuid_t uuid_source) {
   esp_bt_uuid_t uuid = espbt::ESPBTUUID::from_uuid(uuid_source).as_128bit().get_uuid();
@@ -25,6 +27,20 @@ std::vector<uint64_t> get_128bit_uuid_vec(esp_bt_uuid_t uuid_source) {
 
 BluetoothProxy::BluetoothProxy() { global_bluetooth_proxy = this; }
 
+// Whether a later scan result in the batch is from the same device and has the same data.
+static bool has_later_duplicate(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param *advertisements, size_t index,
+                                size_t count) {
+  const auto &result = advertisements[index];
+  const uint8_t length = result.adv_data_len + result.scan_rsp_len;
+  for (size_t j = index + 1; j < count; j++) {
+    const auto &other = advertisements[j];
+    if (memcmp(result.bda, other.bda, ESP_BD_ADDR_LEN) == 0 && other.adv_data_len + other.scan_rsp_len == length &&
+        memcmp(result.ble_adv, other.ble_adv, length) == 0)
+      return true;
+  }
+  return false;
+}
+
 bool BluetoothProxy::parse_device(const esp32_ble_tracker::ESPBTDevice &device) {
   if (!api::global_api_server->is_connected() || this->api_connection_ == nullptr || this->raw_advertisements_)
     return false;
@@ -39,24 +55,37 @@ bool BluetoothProxy::parse_devices(esp_ble_gap_cb_param_t::ble_scan_result_evt_p
   if (!api::global_api_server->is_connected() || this->api_connection_ == nullptr || !this->raw_advertisements_)
     return false;
 
-  api::BluetoothLERawAdvertisementsResponse resp;
+  // Encode BluetoothLERawAdvertisementsResponse right from the scan results instead of copying them into
+  // BluetoothLERawAdvertisement messages first.
+  auto buffer = this->api_connection_->create_buffer();
+  auto *raw = buffer.get_buffer();
+  raw->reserve(count * MAX_RAW_ADVERTISEMENT_SIZE);
+  size_t sent = 0;
   for (size_t i = 0; i < count; i++) {
     auto &result = advertisements[i];
-    api::BluetoothLERawAdvertisement adv;
-    adv.address = esp32_ble::ble_addr_to_uint64(result.bda);
-    adv.rssi = result.rssi;
-    adv.address_type = result.ble_addr_type;
+    if (this->deduplicate_advertisements_ && has_later_duplicate(advertisements, i, count))
+      continue;
 
     uint8_t length = result.adv_data_len + result.scan_rsp_len;
-    adv.data.reserve(length);
-    for (uint16_t i = 0; i < length; i++) {
-      adv.data.push_back(result.ble_adv[i]);
-    }
-
-    resp.advertisements.push_back(std::move(adv));
+    // repeated BluetoothLERawAdvertisement advertisements = 1;
+    buffer.encode_field_raw(1, 2);
+    // the nested message is always shorter than 128 bytes, so its length is a single byte varint
+    const size_t length_pos = raw->size();
+    buffer.write(0);
+    // uint64 address = 1;
+    buffer.encode_uint64(1, esp32_ble::ble_addr_to_uint64(result.bda));
+    // sint32 rssi = 2;
+    buffer.encode_sint32(2, result.rssi);
+    // uint32 address_type = 3;
+    buffer.encode_uint32(3, result.ble_addr_type);
+    // bytes data = 4;
+    buffer.encode_bytes(4, result.ble_adv, length);
+    (*raw)[length_pos] = raw->size() - length_pos - 1;
+    sent++;
   }
-  ESP_LOGV(TAG, "Proxying %d packets", count);
-  this->api_connection_->send_bluetooth_le_raw_advertisements_response(resp);
+  ESP_LOGV(TAG, "Proxying %d packets", sent);
+  // BluetoothLERawAdvertisementsResponse - 93
+  this->api_connection_->send_buffer(buffer, 93);
   return true;
 }
 void BluetoothProxy::send_api_packet_(const esp32_ble_tracker::ESPBTDevice &device) {
@@ -87,6 +116,7 @@ void BluetoothProxy::send_api_packet_(const esp32_ble_tracker::ESPBTDevice &devi
 void BluetoothProxy::dump_config() {
   ESP_LOGCONFIG(TAG, "Bluetooth Proxy:");
   ESP_LOGCONFIG(TAG, "  Active: %s", YESNO(this->active_));
+  ESP_LOGCONFIG(TAG, "  Deduplicate Advertisements: %s", YESNO(this->deduplicate_advertisements_));
 }
 
 int BluetoothProxy::get_bluetooth_connections_free() {
@@ -121,6 +151,12 @@ void BluetoothProxy::loop() {
         connection->release_services();
       }
     } else if (connection->send_service_ >= 0) {
+      const auto *database = esp32_ble_client::global_gatt_cache.get(connection->get_address());
+      if (database != nullptr) {
+        this->send_gatt_service_(connection, *database, connection->send_service_);
+        connection->send_service_++;
+        continue;
+      }
       esp_gattc_service_elem_t service_result;
       uint16_t service_count = 1;
       esp_gatt_status_t service_status =
@@ -198,6 +234,42 @@ void BluetoothProxy::loop() {
   }
 }
 
+void BluetoothProxy::send_gatt_service_(BluetoothConnection *connection,
+                                        const esp32_ble_client::GATTDatabase &database, int16_t index) {
+  // skip to the service, its characteristics and descriptors follow it
+  auto it = database.begin();
+  for (int16_t found = -1; it != database.end(); ++it) {
+    if (it->type == esp32_ble_client::GATT_ATTRIBUTE_SERVICE && ++found == index)
+      break;
+  }
+  if (it == database.end()) {
+    ESP_LOGE(TAG, "[%d] [%s] Cached service missing at offset=%d", connection->get_connection_index(),
+             connection->address_str().c_str(), index);
+    return;
+  }
+  api::BluetoothGATTGetServicesResponse resp;
+  resp.address = connection->get_address();
+  api::BluetoothGATTService service_resp;
+  service_resp.uuid = get_128bit_uuid_vec(it->uuid);
+  service_resp.handle = it->handle;
+  for (++it; it != database.end() && it->type != esp32_ble_client::GATT_ATTRIBUTE_SERVICE; ++it) {
+    if (it->type == esp32_ble_client::GATT_ATTRIBUTE_CHARACTERISTIC) {
+      api::BluetoothGATTCharacteristic characteristic_resp;
+      characteristic_resp.uuid = get_128bit_uuid_vec(it->uuid);
+      characteristic_resp.handle = it->handle;
+      characteristic_resp.properties = it->properties;
+      service_resp.characteristics.push_back(std::move(characteristic_resp));
+    } else if (it->type == esp32_ble_client::GATT_ATTRIBUTE_DESCRIPTOR && !service_resp.characteristics.empty()) {
+      api::BluetoothGATTDescriptor descriptor_resp;
+      descriptor_resp.uuid = get_128bit_uuid_vec(it->uuid);
+      descriptor_resp.handle = it->handle;
+      service_resp.characteristics.back().descriptors.push_back(std::move(descriptor_resp));
+    }
+  }
+  resp.services.push_back(std::move(service_resp));
+  this->api_connection_->send_bluetooth_gatt_get_services_response(resp);
+}
+
 BluetoothConnection *BluetoothProxy::get_connection_(uint64_t address, bool reserve) {
   for (auto *connection : this->connections_) {
     if (connection->get_address() == address)
@@ -234,8 +306,7 @@ void BluetoothProxy::bluetooth_device_request(const api::BluetoothDeviceRequest
         this->send_device_connection(msg.address, false);
         return;
       }
-      if (connection->state() == espbt::ClientState::CONNECTED ||
-          connection->state() == espbt::ClientState::ESTABLISHED) {
+      if (connection->state() == espbt::ClientState::ESTABLISHED) {
         ESP_LOGW(TAG, "[%d] [%s] Connection already established", connection->get_connection_index(),
                  connection->address_str().c_str());
         this->send_device_connection(msg.address, true);
@@ -253,7 +324,8 @@ void BluetoothProxy::bluetooth_device_request(const api::BluetoothDeviceRequest
         ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, waiting in line to connect",
                  connection->get_connection_index(), connection->address_str().c_str());
         return;
-      } else if (connection->state() == espbt::ClientState::CONNECTING) {
+      } else if (connection->state() == espbt::ClientState::CONNECTING ||
+                 connection->state() == espbt::ClientState::CONNECTED) {
         ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, already connecting", connection->get_connection_index(),
                  connection->address_str().c_str());
         return;
@@ -329,6 +401,7 @@ void BluetoothProxy::bluetooth_device_request(const api::BluetoothDeviceRequest
       esp_bd_addr_t address;
       uint64_to_bd_addr(msg.address, address);
       esp_err_t ret = esp_ble_gattc_cache_clean(address);
+      esp32_ble_client::global_gatt_cache.invalidate(msg.address);
       api::BluetoothDeviceClearCacheResponse call;
       call.address = msg.address;
       call.success = ret == ESP_OK;
@@ -90,6 +90,7 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   }
 
   void set_active(bool active) { this->active_ = active; }
+  void set_deduplicate_advertisements(bool deduplicate) { this->deduplicate_advertisements_ = deduplicate; }
   bool has_active() { return this->active_; }
 
   uint32_t get_legacy_version() const {
@@ -117,8 +118,13 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   void send_api_packet_(const esp32_ble_tracker::ESPBTDevice &device);
 
   BluetoothConnection *get_connection_(uint64_t address, bool reserve);
+  /// Send the service at the given index of a cached database.
+  void send_gatt_service_(BluetoothConnection *connection, const esp32_ble_client::GATTDatabase &database,
+                          int16_t index);
 
   bool active_;
+  /// Send repeated advertisements of a batch only once, with the RSSI of the latest.
+  bool deduplicate_advertisements_{false};
 
   std::vector<BluetoothConnection *> connections_{};
   api::APIConnection *api_connection_{nullptr};
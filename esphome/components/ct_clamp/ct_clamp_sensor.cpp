@@ -11,19 +11,46 @@ static const char *const TAG = "ct_clamp";
 void CTClampSensor::dump_config() {
   LOG_SENSOR("", "CT Clamp Sensor", this);
   ESP_LOGCONFIG(TAG, "  Sample Duration: %.2fs", this->sample_duration_ / 1e3f);
+  if (this->source_->supports_continuous())
+    ESP_LOGCONFIG(TAG, "  Sample Rate: %u Hz", this->sample_rate_);
   LOG_UPDATE_INTERVAL(this);
 }
 
 void CTClampSensor::update() {
-  // Update only starts the sampling phase, in loop() the actual sampling is happening.
+  // Update only starts the sampling phase, the samples are collected by the source in the background or in loop().
+  if (this->is_sampling_) {
+    ESP_LOGW(TAG, "'%s' - Still sampling, skipping update. Use an update interval longer than the sample duration.",
+             this->name_.c_str());
+    return;
+  }
+  if (this->source_->is_continuous()) {
+    // Another consumer samples the source continuously, it can't be read until that one is done.
+    ESP_LOGD(TAG, "'%s' - Source is busy, skipping update", this->name_.c_str());
+    return;
+  }
 
-  // Request a high loop() execution interval during sampling phase.
-  this->high_freq_.start();
+  // Set sampling values
+  this->last_value_ = 0.0;
+  this->num_samples_ = 0;
+  this->sample_mean_ = 0.0f;
+  this->sample_m2_ = 0.0f;
+  this->is_sampling_ = true;
+
+  this->is_continuous_ = this->source_->start_continuous(
+      this->sample_rate_, [this](const float *samples, size_t count) { this->add_samples_(samples, count); });
+  if (!this->is_continuous_) {
+    // Request a high loop() execution interval during sampling phase.
+    this->high_freq_.start();
+  }
 
   // Set timeout for ending sampling phase
   this->set_timeout("read", this->sample_duration_, [this]() {
     this->is_sampling_ = false;
-    this->high_freq_.stop();
+    if (this->is_continuous_) {
+      this->source_->stop_continuous();
+    } else {
+      this->high_freq_.stop();
+    }
 
     if (this->num_samples_ == 0) {
       // Shouldn't happen, but let's not crash if it does.
@@ -31,27 +58,17 @@ void CTClampSensor::update() {
       return;
     }
 
-    const float rms_ac_dc_squared = this->sample_squared_sum_ / this->num_samples_;
-    const float rms_dc = this->sample_sum_ / this->num_samples_;
-    const float rms_ac_squared = rms_ac_dc_squared - rms_dc * rms_dc;
     float rms_ac = 0;
-    if (rms_ac_squared > 0)
-      rms_ac = std::sqrt(rms_ac_squared);
+    if (this->sample_m2_ > 0)
+      rms_ac = std::sqrt(this->sample_m2_ / this->num_samples_);
     ESP_LOGD(TAG, "'%s' - Raw AC Value: %.3fA after %d different samples (%d SPS)", this->name_.c_str(), rms_ac,
              this->num_samples_, 1000 * this->num_samples_ / this->sample_duration_);
     this->publish_state(rms_ac);
   });
-
-  // Set sampling values
-  this->last_value_ = 0.0;
-  this->num_samples_ = 0;
-  this->sample_sum_ = 0.0f;
-  this->sample_squared_sum_ = 0.0f;
-  this->is_sampling_ = true;
 }
 
 void CTClampSensor::loop() {
-  if (!this->is_sampling_)
+  if (!this->is_sampling_ || this->is_continuous_)
     return;
 
   // Perform a single sample
@@ -64,9 +81,28 @@ void CTClampSensor::loop() {
     return;
   this->last_value_ = value;
 
-  this->num_samples_++;
-  this->sample_sum_ += value;
-  this->sample_squared_sum_ += value * value;
+  this->add_samples_(&value, 1);
+}
+
+void CTClampSensor::add_samples_(const float *samples, size_t count) {
+  if (count == 0)
+    return;
+
+  float block_sum = 0.0f;
+  for (size_t i = 0; i < count; i++)
+    block_sum += samples[i];
+  const float block_mean = block_sum / count;
+  float block_m2 = 0.0f;
+  for (size_t i = 0; i < count; i++) {
+    const float deviation = samples[i] - block_mean;
+    block_m2 += deviation * deviation;
+  }
+
+  const uint32_t total = this->num_samples_ + count;
+  const float delta = block_mean - this->sample_mean_;
+  this->sample_mean_ += delta * count / total;
+  this->sample_m2_ += block_m2 + delta * delta * (float(this->num_samples_) * count / total);
+  this->num_samples_ = total;
 }
 
 }  // namespace ct_clamp
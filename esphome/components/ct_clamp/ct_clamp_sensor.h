@@ -19,14 +19,20 @@ class CTClampSensor : public sensor::Sensor, public PollingComponent {
   }
 
   void set_sample_duration(uint32_t sample_duration) { sample_duration_ = sample_duration; }
+  void set_sample_rate(uint32_t sample_rate) { sample_rate_ = sample_rate; }
   void set_source(voltage_sampler::VoltageSampler *source) { source_ = source; }
 
  protected:
   /// High Frequency loop() requester used during sampling phase.
   HighFrequencyLoopRequester high_freq_;
 
+  /// Add a block of samples to the running mean and variance.
+  void add_samples_(const float *samples, size_t count);
+
   /// Duration in ms of the sampling phase.
   uint32_t sample_duration_;
+  /// Requested sample rate in Hz when the source supports continuous sampling.
+  uint32_t sample_rate_;
   /// The sampling source to read values from.
   voltage_sampler::VoltageSampler *source_;
 
@@ -35,18 +41,17 @@ class CTClampSensor : public sensor::Sensor, public PollingComponent {
    * Diagram: https://learn.openenergymonitor.org/electricity-monitoring/ct-sensors/interface-with-arduino
    *
    * The current clamp only measures AC, so any DC component is an unwanted artifact from the
-   * sampling circuit. The AC component is essentially the same as the calculating the Standard-Deviation,
-   * which can be done by cumulating 3 values per sample:
-   *   1) Number of samples
-   *   2) Sum of samples
-   *   3) Sum of sample squared
-   * https://en.wikipedia.org/wiki/Root_mean_square
+   * sampling circuit. The AC component is essentially the same as the calculating the Standard-Deviation.
+   * The mean and the sum of squared deviations are computed per block of samples and merged into the
+   * running values, which avoids the cancellation of summing the raw squares:
+   * https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm
    */
 
   float last_value_ = 0.0f;
-  float sample_sum_ = 0.0f;
-  float sample_squared_sum_ = 0.0f;
+  float sample_mean_ = 0.0f;
+  float sample_m2_ = 0.0f;
   uint32_t num_samples_ = 0;
+  bool is_continuous_ = false;
   bool is_sampling_ = false;
 };
 
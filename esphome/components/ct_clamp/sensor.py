@@ -12,6 +12,7 @@ AUTO_LOAD = ["voltage_sampler"]
 CODEOWNERS = ["@jesserockz"]
 
 CONF_SAMPLE_DURATION = "sample_duration"
+CONF_SAMPLE_RATE = "sample_rate"
 
 ct_clamp_ns = cg.esphome_ns.namespace("ct_clamp")
 CTClampSensor = ct_clamp_ns.class_("CTClampSensor", sensor.Sensor, cg.PollingComponent)
@@ -30,6 +31,9 @@ CONFIG_SCHEMA = (
             cv.Optional(
                 CONF_SAMPLE_DURATION, default="200ms"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_SAMPLE_RATE, default="20kHz"): cv.All(
+                cv.frequency, cv.float_range(min=1)
+            ),
         }
     )
     .extend(cv.polling_component_schema("60s"))
@@ -43,3 +47,4 @@ async def to_code(config):
     sens = await cg.get_variable(config[CONF_SENSOR])
     cg.add(var.set_source(sens))
     cg.add(var.set_sample_duration(config[CONF_SAMPLE_DURATION]))
+    cg.add(var.set_sample_rate(int(config[CONF_SAMPLE_RATE])))
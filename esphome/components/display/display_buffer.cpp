@@ -180,10 +180,77 @@ void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
     }
   }
 }
+void HOT DisplayBuffer::blend_row(int x, int y, const uint8_t *alpha, int width, Color color) {
+  Rect clip = this->get_clipping();
+  if (this->rotation_ != DISPLAY_ROTATION_0_DEGREES) {
+    // the row is not contiguous in the buffer, blend pixel by pixel
+    for (int i = 0; i < width; i++) {
+      int px = x + i, py = y;
+      if (alpha[i] == 0 || !clip.inside(px, py))
+        continue;
+      switch (this->rotation_) {
+        case DISPLAY_ROTATION_90_DEGREES:
+          std::swap(px, py);
+          px = this->get_width_internal() - px - 1;
+          break;
+        case DISPLAY_ROTATION_180_DEGREES:
+          px = this->get_width_internal() - px - 1;
+          py = this->get_height_internal() - py - 1;
+          break;
+        default:
+          std::swap(px, py);
+          py = this->get_height_internal() - py - 1;
+          break;
+      }
+      if (px >= 0 && px < this->get_width_internal() && py >= 0 && py < this->get_height_internal())
+        this->blend_absolute_row_internal(px, py, alpha + i, 1, color);
+    }
+    App.feed_wdt();
+    return;
+  }
+
+  int start, end;
+  if (!this->clip_row_(x, y, width, clip, &start, &end))
+    return;
+  this->blend_absolute_row_internal(start, y, alpha + (start - x), end - start + 1, color);
+  App.feed_wdt();
+}
+void DisplayBuffer::blend_absolute_row_internal(int x, int y, const uint8_t *alpha, int width, Color color) {
+  for (int i = 0; i < width; i++) {
+    if (alpha[i] >= 0x80)
+      this->draw_absolute_pixel_internal(x + i, y, color);
+  }
+}
+bool DisplayBuffer::clip_row_(int x, int y, int width, Rect clip, int *start, int *end) {
+  int x_min = 0, x_max = this->get_width_internal() - 1;
+  if (y < 0 || y >= this->get_height_internal())
+    return false;
+  if (clip.is_set()) {
+    if (y < clip.y || y > clip.y2())
+      return false;
+    x_min = std::max<int>(x_min, clip.x);
+    x_max = std::min<int>(x_max, clip.x2());
+  }
+  *start = std::max(x, x_min);
+  *end = std::min(x + width - 1, x_max);
+  return *start <= *end;
+}
 void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  if (this->rotation_ != DISPLAY_ROTATION_0_DEGREES) {
+    // the line is not contiguous in the buffer, draw pixel by pixel
+    for (int i = x; i < x + width; i++)
+      this->draw_pixel_at(i, y, color);
+    return;
+  }
+  int start, end;
+  if (!this->clip_row_(x, y, width, this->get_clipping(), &start, &end))
+    return;
+  this->fill_absolute_row_internal(start, y, end - start + 1, color);
+  App.feed_wdt();
+}
+void DisplayBuffer::fill_absolute_row_internal(int x, int y, int width, Color color) {
+  for (int i = 0; i < width; i++)
+    this->draw_absolute_pixel_internal(x + i, y, color);
 }
 void HOT DisplayBuffer::vertical_line(int x, int y, int height, Color color) {
   // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
@@ -259,10 +326,12 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
 
   int i = 0;
   int x_at = x_start;
+  int prev_glyph_n = -1;
   while (text[i] != '\0') {
     int match_length;
     int glyph_n = font->match_next_glyph(text + i, &match_length);
     if (glyph_n < 0) {
+      prev_glyph_n = -1;
       // Unknown char, skip
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
       if (!font->get_glyphs().empty()) {
@@ -278,19 +347,21 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
       continue;
     }
 
+    if (prev_glyph_n >= 0)
+      x_at += font->get_kerning(prev_glyph_n, glyph_n);
+    prev_glyph_n = glyph_n;
+
     const Glyph &glyph = font->get_glyphs()[glyph_n];
     int scan_x1, scan_y1, scan_width, scan_height;
     glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
 
-    {
-      const int glyph_x_max = scan_x1 + scan_width;
-      const int glyph_y_max = scan_y1 + scan_height;
-      for (int glyph_x = scan_x1; glyph_x < glyph_x_max; glyph_x++) {
-        for (int glyph_y = scan_y1; glyph_y < glyph_y_max; glyph_y++) {
-          if (glyph.get_pixel(glyph_x, glyph_y)) {
-            this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-          }
-        }
+    // glyphs are drawn row by row, 1 bpp rows are fully opaque or transparent
+    uint8_t alpha[64];
+    for (int glyph_y = 0; glyph_y < scan_height; glyph_y++) {
+      for (int glyph_x = 0; glyph_x < scan_width; glyph_x += sizeof(alpha)) {
+        const int run = std::min<int>(sizeof(alpha), scan_width - glyph_x);
+        glyph.get_row_alpha(glyph_y, glyph_x, run, alpha);
+        this->blend_row(x_at + scan_x1 + glyph_x, y_start + scan_y1 + glyph_y, alpha, run, color);
       }
     }
 
@@ -309,6 +380,11 @@ void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign al
 void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color color_off) {
   bool transparent = image->has_transparency();
 
+  if (image->get_compression() == IMAGE_COMPRESSION_RLE) {
+    image->draw_rle(this, x, y);
+    return;
+  }
+
   switch (image->get_type()) {
     case IMAGE_TYPE_BINARY: {
       for (int img_x = 0; img_x < image->get_width(); img_x++) {
@@ -546,10 +622,29 @@ bool Glyph::get_pixel(int x, int y) const {
   const int y_data = y - this->glyph_data_->offset_y;
   if (x_data < 0 || x_data >= this->glyph_data_->width || y_data < 0 || y_data >= this->glyph_data_->height)
     return false;
+  if (this->bpp_ > 1) {
+    uint8_t alpha;
+    this->get_row_alpha(y_data, x_data, 1, &alpha);
+    return alpha >= 0x80;
+  }
   const uint32_t width_8 = ((this->glyph_data_->width + 7u) / 8u) * 8u;
   const uint32_t pos = x_data + y_data * width_8;
   return progmem_read_byte(this->glyph_data_->data + (pos / 8u)) & (0x80 >> (pos % 8u));
 }
+void HOT Glyph::get_row_alpha(int y, int x, int width, uint8_t *alpha) const {
+  // rows start on a byte boundary, pixels are packed MSB first
+  const uint32_t stride = (this->glyph_data_->width * this->bpp_ + 7u) / 8u;
+  const uint8_t *row = this->glyph_data_->data + y * stride;
+  const uint8_t max_value = (1u << this->bpp_) - 1u;
+  const uint8_t scale = 255u / max_value;
+  uint32_t bit = x * this->bpp_;
+  uint8_t byte = progmem_read_byte(row + bit / 8u);
+  for (int i = 0; i < width; i++, bit += this->bpp_) {
+    if (bit % 8u == 0)
+      byte = progmem_read_byte(row + bit / 8u);
+    alpha[i] = ((byte >> (8u - this->bpp_ - bit % 8u)) & max_value) * scale;
+  }
+}
 const char *Glyph::get_char() const { return this->glyph_data_->a_char; }
 bool Glyph::compare_to(const char *str) const {
   // 1 -> this->char_
@@ -606,10 +701,12 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   int min_x = 0;
   bool has_char = false;
   int x = 0;
+  int prev_glyph_n = -1;
   while (str[i] != '\0') {
     int match_length;
     int glyph_n = this->match_next_glyph(str + i, &match_length);
     if (glyph_n < 0) {
+      prev_glyph_n = -1;
       // Unknown char, skip
       if (!this->get_glyphs().empty())
         x += this->get_glyphs()[0].glyph_data_->width;
@@ -617,6 +714,10 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
       continue;
     }
 
+    if (prev_glyph_n >= 0)
+      x += this->get_kerning(prev_glyph_n, glyph_n);
+    prev_glyph_n = glyph_n;
+
     const Glyph &glyph = this->glyphs_[glyph_n];
     if (!has_char) {
       min_x = glyph.glyph_data_->offset_x;
@@ -631,10 +732,31 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   *x_offset = min_x;
   *width = x - min_x;
 }
-Font::Font(const GlyphData *data, int data_nr, int baseline, int height) : baseline_(baseline), height_(height) {
+Font::Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t bpp)
+    : baseline_(baseline), height_(height), bpp_(bpp) {
   glyphs_.reserve(data_nr);
   for (int i = 0; i < data_nr; ++i)
-    glyphs_.emplace_back(&data[i]);
+    glyphs_.emplace_back(&data[i], bpp);
+}
+void Font::set_kerning(const KerningData *data, int data_nr) {
+  this->kerning_ = data;
+  this->kerning_nr_ = data_nr;
+}
+int Font::get_kerning(int first, int second) const {
+  int lo = 0;
+  int hi = this->kerning_nr_ - 1;
+  while (lo <= hi) {
+    const int mid = (lo + hi) / 2;
+    const KerningData &pair = this->kerning_[mid];
+    if (pair.first == first && pair.second == second)
+      return pair.offset;
+    if (pair.first < first || (pair.first == first && pair.second < second)) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return 0;
 }
 
 bool Image::get_pixel(int x, int y) const {
@@ -647,16 +769,29 @@ bool Image::get_pixel(int x, int y) const {
 Color Image::get_rgba_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return Color::BLACK;
-  const uint32_t pos = (x + y * this->width_) * 4;
-  return Color(progmem_read_byte(this->data_start_ + pos + 0), progmem_read_byte(this->data_start_ + pos + 1),
-               progmem_read_byte(this->data_start_ + pos + 2), progmem_read_byte(this->data_start_ + pos + 3));
+  return this->decode_rgba_(this->get_pixel_data_(x, y, 0, 4));
 }
 Color Image::get_color_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return Color::BLACK;
-  const uint32_t pos = (x + y * this->width_) * 3;
-  Color color = Color(progmem_read_byte(this->data_start_ + pos + 0), progmem_read_byte(this->data_start_ + pos + 1),
-                      progmem_read_byte(this->data_start_ + pos + 2));
+  return this->decode_rgb24_(this->get_pixel_data_(x, y, 0, 3));
+}
+Color Image::get_rgb565_pixel(int x, int y) const {
+  if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
+    return Color::BLACK;
+  return this->decode_rgb565_(this->get_pixel_data_(x, y, 0, 2));
+}
+Color Image::get_grayscale_pixel(int x, int y) const {
+  if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
+    return Color::BLACK;
+  return this->decode_grayscale_(this->get_pixel_data_(x, y, 0, 1));
+}
+Color Image::decode_rgba_(const uint8_t *data) const {
+  return Color(progmem_read_byte(data + 0), progmem_read_byte(data + 1), progmem_read_byte(data + 2),
+               progmem_read_byte(data + 3));
+}
+Color Image::decode_rgb24_(const uint8_t *data) const {
+  Color color = Color(progmem_read_byte(data + 0), progmem_read_byte(data + 1), progmem_read_byte(data + 2));
   if (color.b == 1 && color.r == 0 && color.g == 0 && transparent_) {
     // (0, 0, 1) has been defined as transparent color for non-alpha images.
     // putting blue == 1 as a first condition for performance reasons (least likely value to short-cut the if)
@@ -666,12 +801,8 @@ Color Image::get_color_pixel(int x, int y) const {
   }
   return color;
 }
-Color Image::get_rgb565_pixel(int x, int y) const {
-  if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
-    return Color::BLACK;
-  const uint32_t pos = (x + y * this->width_) * 2;
-  uint16_t rgb565 =
-      progmem_read_byte(this->data_start_ + pos + 0) << 8 | progmem_read_byte(this->data_start_ + pos + 1);
+Color Image::decode_rgb565_(const uint8_t *data) const {
+  uint16_t rgb565 = progmem_read_byte(data + 0) << 8 | progmem_read_byte(data + 1);
   auto r = (rgb565 & 0xF800) >> 11;
   auto g = (rgb565 & 0x07E0) >> 5;
   auto b = rgb565 & 0x001F;
@@ -684,14 +815,90 @@ Color Image::get_rgb565_pixel(int x, int y) const {
   }
   return color;
 }
-Color Image::get_grayscale_pixel(int x, int y) const {
-  if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
-    return Color::BLACK;
-  const uint32_t pos = (x + y * this->width_);
-  const uint8_t gray = progmem_read_byte(this->data_start_ + pos);
+Color Image::decode_grayscale_(const uint8_t *data) const {
+  const uint8_t gray = progmem_read_byte(data);
   uint8_t alpha = (gray == 1 && transparent_) ? 0 : 0xFF;
   return Color(gray, gray, gray, alpha);
 }
+Color Image::decode_pixel_(const uint8_t *data) const {
+  switch (this->type_) {
+    case IMAGE_TYPE_GRAYSCALE:
+      return this->decode_grayscale_(data);
+    case IMAGE_TYPE_RGB565:
+      return this->decode_rgb565_(data);
+    case IMAGE_TYPE_RGB24:
+      return this->decode_rgb24_(data);
+    case IMAGE_TYPE_RGBA:
+      return this->decode_rgba_(data);
+    default:
+      return Color::BLACK;
+  }
+}
+uint8_t Image::get_bytes_per_pixel_() const {
+  switch (this->type_) {
+    case IMAGE_TYPE_RGB565:
+      return 2;
+    case IMAGE_TYPE_RGB24:
+      return 3;
+    case IMAGE_TYPE_RGBA:
+      return 4;
+    default:
+      return 1;
+  }
+}
+const uint8_t *Image::get_rle_row_(int y, int frame) const {
+  // the packets are preceded by a table of big-endian offsets, one for each row of every frame
+  const uint8_t *entry = this->data_start_ + (frame * this->height_ + y) * 4;
+  const uint32_t offset = progmem_read_byte(entry) << 24 | progmem_read_byte(entry + 1) << 16 |
+                          progmem_read_byte(entry + 2) << 8 | progmem_read_byte(entry + 3);
+  return this->data_start_ + offset;
+}
+const uint8_t *Image::get_pixel_data_(int x, int y, int frame, uint8_t bytes_per_pixel) const {
+  if (this->compression_ != IMAGE_COMPRESSION_RLE)
+    return this->data_start_ + (x + y * this->width_ + this->width_ * this->height_ * frame) * bytes_per_pixel;
+
+  const uint8_t *packet = this->get_rle_row_(y, frame);
+  int pos = 0;
+  while (true) {
+    const uint8_t header = progmem_read_byte(packet++);
+    const int count = (header & 0x7F) + 1;
+    if (header & 0x80) {
+      if (x < pos + count)
+        return packet;
+      packet += bytes_per_pixel;
+    } else {
+      if (x < pos + count)
+        return packet + (x - pos) * bytes_per_pixel;
+      packet += count * bytes_per_pixel;
+    }
+    pos += count;
+  }
+}
+void Image::draw_rle(DisplayBuffer *display, int x, int y) const {
+  const int frame = this->get_current_frame();
+  const uint8_t bytes_per_pixel = this->get_bytes_per_pixel_();
+  for (int img_y = 0; img_y < this->height_; img_y++) {
+    const uint8_t *packet = this->get_rle_row_(img_y, frame);
+    int img_x = 0;
+    while (img_x < this->width_) {
+      const uint8_t header = progmem_read_byte(packet++);
+      const int count = (header & 0x7F) + 1;
+      if (header & 0x80) {
+        auto color = this->decode_pixel_(packet);
+        if (color.w >= 0x80)
+          display->horizontal_line(x + img_x, y + img_y, count, color);
+        packet += bytes_per_pixel;
+      } else {
+        for (int i = 0; i < count; i++, packet += bytes_per_pixel) {
+          auto color = this->decode_pixel_(packet);
+          if (color.w >= 0x80)
+            display->draw_pixel_at(x + img_x + i, y + img_y, color);
+        }
+      }
+      img_x += count;
+    }
+  }
+}
 int Image::get_width() const { return this->width_; }
 int Image::get_height() const { return this->height_; }
 ImageType Image::get_type() const { return this->type_; }
@@ -715,9 +922,7 @@ Color Animation::get_rgba_pixel(int x, int y) const {
   const uint32_t frame_index = this->width_ * this->height_ * this->current_frame_;
   if (frame_index >= (uint32_t) (this->width_ * this->height_ * this->animation_frame_count_))
     return Color::BLACK;
-  const uint32_t pos = (x + y * this->width_ + frame_index) * 4;
-  return Color(progmem_read_byte(this->data_start_ + pos + 0), progmem_read_byte(this->data_start_ + pos + 1),
-               progmem_read_byte(this->data_start_ + pos + 2), progmem_read_byte(this->data_start_ + pos + 3));
+  return this->decode_rgba_(this->get_pixel_data_(x, y, this->current_frame_, 4));
 }
 Color Animation::get_color_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
@@ -725,17 +930,7 @@ Color Animation::get_color_pixel(int x, int y) const {
   const uint32_t frame_index = this->width_ * this->height_ * this->current_frame_;
   if (frame_index >= (uint32_t) (this->width_ * this->height_ * this->animation_frame_count_))
     return Color::BLACK;
-  const uint32_t pos = (x + y * this->width_ + frame_index) * 3;
-  Color color = Color(progmem_read_byte(this->data_start_ + pos + 0), progmem_read_byte(this->data_start_ + pos + 1),
-                      progmem_read_byte(this->data_start_ + pos + 2));
-  if (color.b == 1 && color.r == 0 && color.g == 0 && transparent_) {
-    // (0, 0, 1) has been defined as transparent color for non-alpha images.
-    // putting blue == 1 as a first condition for performance reasons (least likely value to short-cut the if)
-    color.w = 0;
-  } else {
-    color.w = 0xFF;
-  }
-  return color;
+  return this->decode_rgb24_(this->get_pixel_data_(x, y, this->current_frame_, 3));
 }
 Color Animation::get_rgb565_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
@@ -743,20 +938,7 @@ Color Animation::get_rgb565_pixel(int x, int y) const {
   const uint32_t frame_index = this->width_ * this->height_ * this->current_frame_;
   if (frame_index >= (uint32_t) (this->width_ * this->height_ * this->animation_frame_count_))
     return Color::BLACK;
-  const uint32_t pos = (x + y * this->width_ + frame_index) * 2;
-  uint16_t rgb565 =
-      progmem_read_byte(this->data_start_ + pos + 0) << 8 | progmem_read_byte(this->data_start_ + pos + 1);
-  auto r = (rgb565 & 0xF800) >> 11;
-  auto g = (rgb565 & 0x07E0) >> 5;
-  auto b = rgb565 & 0x001F;
-  Color color = Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
-  if (rgb565 == 0x0020 && transparent_) {
-    // darkest green has been defined as transparent color for transparent RGB565 images.
-    color.w = 0;
-  } else {
-    color.w = 0xFF;
-  }
-  return color;
+  return this->decode_rgb565_(this->get_pixel_data_(x, y, this->current_frame_, 2));
 }
 Color Animation::get_grayscale_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
@@ -764,10 +946,7 @@ Color Animation::get_grayscale_pixel(int x, int y) const {
   const uint32_t frame_index = this->width_ * this->height_ * this->current_frame_;
   if (frame_index >= (uint32_t) (this->width_ * this->height_ * this->animation_frame_count_))
     return Color::BLACK;
-  const uint32_t pos = (x + y * this->width_ + frame_index);
-  const uint8_t gray = progmem_read_byte(this->data_start_ + pos);
-  uint8_t alpha = (gray == 1 && transparent_) ? 0 : 0xFF;
-  return Color(gray, gray, gray, alpha);
+  return this->decode_grayscale_(this->get_pixel_data_(x, y, this->current_frame_, 1));
 }
 Animation::Animation(const uint8_t *data_start, int width, int height, uint32_t animation_frame_count, ImageType type)
     : Image(data_start, width, height, type),
@@ -83,6 +83,12 @@ enum ImageType {
   IMAGE_TYPE_RGBA = 4,
 };
 
+enum ImageCompression {
+  IMAGE_COMPRESSION_NONE = 0,
+  /// Rows are run-length encoded, see Image::draw_rle().
+  IMAGE_COMPRESSION_RLE = 1,
+};
+
 enum DisplayType {
   DISPLAY_TYPE_BINARY = 1,
   DISPLAY_TYPE_GRAYSCALE = 2,
@@ -156,6 +162,12 @@ class DisplayBuffer {
   /// Draw a straight line from the point [x1,y1] to [x2,y2] with the given color.
   void line(int x1, int y1, int x2, int y2, Color color = COLOR_ON);
 
+  /** Blend a horizontal run of partially covered pixels in the given color, starting at [x,y].
+   *
+   * @param alpha Coverage of each pixel, 0 leaves the pixel untouched and 255 replaces it with color.
+   */
+  void blend_row(int x, int y, const uint8_t *alpha, int width, Color color);
+
   /// Draw a horizontal line from the point [x,y] to [x+width,y] with the given color.
   void horizontal_line(int x, int y, int width, Color color = COLOR_ON);
 
@@ -443,6 +455,23 @@ class DisplayBuffer {
 
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  /** Blend a horizontal run of pixels in absolute coordinates, already clipped to the display.
+   *
+   * Displays that can read back their buffer should override this. The default implementation draws every pixel
+   * that is at least half covered.
+   */
+  virtual void blend_absolute_row_internal(int x, int y, const uint8_t *alpha, int width, Color color);
+
+  /** Fill a horizontal run of pixels in absolute coordinates, already clipped to the display.
+   *
+   * Displays with a linear buffer should override this to fill the run at once. The default implementation draws
+   * the pixels one by one.
+   */
+  virtual void fill_absolute_row_internal(int x, int y, int width, Color color);
+
+  /// Clip the row [x,y] to [x+width-1,y] to the display and the clipping rectangle, false if nothing is left.
+  bool clip_row_(int x, int y, int width, Rect clip, int *start, int *end);
+
   void init_internal_(uint32_t buffer_length);
 
   void do_update_();
@@ -484,12 +513,28 @@ struct GlyphData {
   int height;
 };
 
+/// Horizontal adjustment applied between two glyphs, identified by their index in the font.
+struct KerningData {
+  uint16_t first;
+  uint16_t second;
+  int16_t offset;
+};
+
 class Glyph {
  public:
-  Glyph(const GlyphData *data) : glyph_data_(data) {}
+  Glyph(const GlyphData *data, uint8_t bpp = 1) : glyph_data_(data), bpp_(bpp) {}
 
   bool get_pixel(int x, int y) const;
 
+  /** Read the coverage of a run of pixels in a glyph row, scaled to 0-255.
+   *
+   * @param y The row, relative to the glyph bitmap (without offset).
+   * @param x The first column, relative to the glyph bitmap (without offset).
+   * @param width Number of pixels to read.
+   * @param alpha Receives width coverage values.
+   */
+  void get_row_alpha(int y, int x, int width, uint8_t *alpha) const;
+
   const char *get_char() const;
 
   bool compare_to(const char *str) const;
@@ -503,6 +548,7 @@ class Glyph {
   friend DisplayBuffer;
 
   const GlyphData *glyph_data_;
+  uint8_t bpp_;
 };
 
 class Font {
@@ -512,14 +558,21 @@ class Font {
    * @param glyphs A vector of glyphs, must be sorted lexicographically.
    * @param baseline The y-offset from the top of the text to the baseline.
    * @param bottom The y-offset from the top of the text to the bottom (i.e. height).
+   * @param bpp The number of bits per pixel of the glyph bitmaps, 1 for plain and 2 or 4 for anti-aliased fonts.
    */
-  Font(const GlyphData *data, int data_nr, int baseline, int height);
+  Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t bpp = 1);
+
+  /// Set the kerning pairs of this font, must be sorted by first and then second glyph index.
+  void set_kerning(const KerningData *data, int data_nr);
+  /// Get the horizontal adjustment between two glyphs, by index.
+  int get_kerning(int first, int second) const;
 
   int match_next_glyph(const char *str, int *match_length);
 
   void measure(const char *str, int *width, int *x_offset, int *baseline, int *height);
   inline int get_baseline() { return this->baseline_; }
   inline int get_height() { return this->height_; }
+  inline uint8_t get_bpp() const { return this->bpp_; }
 
   const std::vector<Glyph, ExternalRAMAllocator<Glyph>> &get_glyphs() const { return glyphs_; }
 
@@ -527,6 +580,9 @@ class Font {
   std::vector<Glyph, ExternalRAMAllocator<Glyph>> glyphs_;
   int baseline_;
   int height_;
+  uint8_t bpp_;
+  const KerningData *kerning_{nullptr};
+  int kerning_nr_{0};
 };
 
 class Image {
@@ -546,12 +602,33 @@ class Image {
   void set_transparency(bool transparent) { transparent_ = transparent; }
   bool has_transparency() const { return transparent_; }
 
+  void set_compression(ImageCompression compression) { compression_ = compression; }
+  ImageCompression get_compression() const { return compression_; }
+
+  /** Draws the current frame of a run-length encoded image, decoding it row by row.
+   *
+   * Runs of a single color are drawn as horizontal lines, fully transparent runs are skipped.
+   */
+  void draw_rle(DisplayBuffer *display, int x, int y) const;
+
  protected:
+  /// Returns the address of the raw bytes of a pixel, for both uncompressed and compressed images.
+  const uint8_t *get_pixel_data_(int x, int y, int frame, uint8_t bytes_per_pixel) const;
+  /// Returns the address of the first packet of a row of a run-length encoded image.
+  const uint8_t *get_rle_row_(int y, int frame) const;
+  uint8_t get_bytes_per_pixel_() const;
+  Color decode_pixel_(const uint8_t *data) const;
+  Color decode_rgba_(const uint8_t *data) const;
+  Color decode_rgb24_(const uint8_t *data) const;
+  Color decode_rgb565_(const uint8_t *data) const;
+  Color decode_grayscale_(const uint8_t *data) const;
+
   int width_;
   int height_;
   ImageType type_;
   const uint8_t *data_start_;
   bool transparent_;
+  ImageCompression compression_{IMAGE_COMPRESSION_NONE};
 };
 
 class Animation : public Image {
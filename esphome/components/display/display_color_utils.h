@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include "esphome/core/color.h"
 
 namespace esphome {
@@ -154,6 +155,45 @@ class ColorUtil {
     Color color = Color(palette[index * 3 + 0], palette[index * 3 + 1], palette[index * 3 + 2], 0);
     return color;
   }
+
+  /***
+   * Blends two RGB565 values.
+   * @param[in] fg The foreground color.
+   * @param[in] bg The background color.
+   * @param[in] alpha The coverage of the foreground, 0 returns bg and 255 returns fg.
+   * @return The blended RGB565 value, rounded per channel.
+   */
+  static inline uint16_t blend_565(uint16_t fg, uint16_t bg, uint8_t alpha) {
+    const uint8_t inv = 255 - alpha;
+    // (v + (v >> 8)) >> 8 divides by 255 with rounding for the +128 biased products below
+    uint16_t r = ((fg >> 11) * alpha + (bg >> 11) * inv + 128);
+    uint16_t g = (((fg >> 5) & 0x3F) * alpha + ((bg >> 5) & 0x3F) * inv + 128);
+    uint16_t b = ((fg & 0x1F) * alpha + (bg & 0x1F) * inv + 128);
+    r = (r + (r >> 8)) >> 8;
+    g = (g + (g >> 8)) >> 8;
+    b = (b + (b >> 8)) >> 8;
+    return r << 11 | g << 5 | b;
+  }
+
+  /// Lookup table mapping every RGB332 value to the RGB565 value color_to_565(rgb332_to_color(x)) yields.
+  static const uint16_t RGB332_TO_565[256];
+
+  /***
+   * Fills a 256 entry lookup table with the RGB565 value of every entry of a 24bit 888 palette.
+   * @param[in] palette The 256*3 byte RGB palette.
+   * @param[out] lut The 256 entry table to fill.
+   */
+  static void palette888_to_565_lut(const uint8_t *palette, uint16_t *lut);
+
+  // Row conversion kernels used when pushing a framebuffer to a display. They process a whole run of pixels at once
+  // and write big-endian RGB565 (2 bytes per pixel) or RGB666 (3 bytes per pixel), ready to be sent over the bus.
+
+  /// Converts count RGB332 pixels to big-endian RGB565.
+  static void rgb332_to_565_be(const uint8_t *src, uint8_t *dst, size_t count);
+  /// Converts count 8bit palette indexes to big-endian RGB565 using a table from palette888_to_565_lut().
+  static void index8_to_565_be(const uint8_t *src, uint8_t *dst, size_t count, const uint16_t *lut);
+  /// Converts count big-endian RGB565 pixels to RGB666, each channel left-aligned in its own byte.
+  static void rgb565_be_to_666(const uint8_t *src, uint8_t *dst, size_t count);
 };
 }  // namespace display
 }  // namespace esphome
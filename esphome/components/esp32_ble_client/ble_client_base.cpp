@@ -3,6 +3,10 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
 #ifdef USE_ESP32
 
 namespace esphome {
@@ -35,6 +39,15 @@ void BLEClientBase::loop() {
   if (this->state_ == espbt::ClientState::READY_TO_CONNECT) {
     this->connect();
   }
+  if (this->cached_search_pending_) {
+    this->cached_search_pending_ = false;
+    // Report the services loaded from the cache the same way as a completed service search,
+    // so everything that waits for discovery carries on as usual.
+    esp_ble_gattc_cb_param_t param{};
+    param.search_cmpl.status = ESP_GATT_OK;
+    param.search_cmpl.conn_id = this->conn_id_;
+    this->gattc_event_handler(ESP_GATTC_SEARCH_CMPL_EVT, (esp_gatt_if_t) this->gattc_if_, &param);
+  }
 }
 
 float BLEClientBase::get_setup_priority() const { return setup_priority::AFTER_BLUETOOTH; }
@@ -63,6 +76,7 @@ void BLEClientBase::connect() {
   ESP_LOGI(TAG, "[%d] [%s] 0x%02x Attempting BLE connection", this->connection_index_, this->address_str_.c_str(),
            this->remote_addr_type_);
   this->paired_ = false;
+  this->connect_started_ = millis();
   auto ret = esp_ble_gattc_open(this->gattc_if_, this->remote_bda_, this->remote_addr_type_, true);
   if (ret) {
     ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_open error, status=%d", this->connection_index_, this->address_str_.c_str(),
@@ -129,6 +143,7 @@ bool BLEClientBase::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_
       ESP_LOGV(TAG, "[%d] [%s] ESP_GATTC_OPEN_EVT", this->connection_index_, this->address_str_.c_str());
       this->conn_id_ = param->open.conn_id;
       this->service_count_ = 0;
+      this->services_from_cache_ = false;
       if (param->open.status != ESP_GATT_OK && param->open.status != ESP_GATT_ALREADY_OPEN) {
         ESP_LOGW(TAG, "[%d] [%s] Connection failed, status=%d", this->connection_index_, this->address_str_.c_str(),
                  param->open.status);
@@ -141,11 +156,29 @@ bool BLEClientBase::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_
                  this->address_str_.c_str(), ret);
       }
       if (this->connection_type_ == espbt::ConnectionType::V3_WITH_CACHE) {
-        ESP_LOGI(TAG, "[%d] [%s] Connected", this->connection_index_, this->address_str_.c_str());
+        ESP_LOGI(TAG, "[%d] [%s] Connected in %" PRIu32 " ms", this->connection_index_, this->address_str_.c_str(),
+                 millis() - this->connect_started_);
         this->set_state(espbt::ClientState::CONNECTED);
         this->state_ = espbt::ClientState::ESTABLISHED;
         break;
       }
+      // The link is up and only service discovery is left, which no longer needs the scanner paused. Leave
+      // CONNECTING without notifying the nodes, so the tracker resumes scanning and connects other clients meanwhile.
+      this->state_ = espbt::ClientState::CONNECTED;
+      const auto *database = global_gatt_cache.get(this->address_);
+      if (database != nullptr) {
+        ESP_LOGD(TAG, "[%d] [%s] Using cached GATT database with %u attributes", this->connection_index_,
+                 this->address_str_.c_str(), (unsigned) database->size());
+        this->load_cached_database_(*database);
+        // Bluedroid discovers the services itself on open, unless it still knows them from an earlier connection.
+        // Report the cached services only once it's done, it refuses requests until then.
+        uint16_t bluedroid_services = 0;
+        if (esp_ble_gattc_get_attr_count(this->gattc_if_, this->conn_id_, ESP_GATT_DB_PRIMARY_SERVICE, 0x0001, 0xFFFF,
+                                         ESP_GATT_ILLEGAL_HANDLE, &bluedroid_services) == ESP_GATT_OK &&
+            bluedroid_services > 0)
+          this->cached_search_pending_ = true;
+        break;
+      }
       esp_ble_gattc_search_service(esp_gattc_if, param->cfg_mtu.conn_id, nullptr);
       break;
     }
@@ -166,10 +199,20 @@ bool BLEClientBase::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_
         return false;
       ESP_LOGV(TAG, "[%d] [%s] ESP_GATTC_DISCONNECT_EVT, reason %d", this->connection_index_,
                this->address_str_.c_str(), param->disconnect.reason);
+      this->cached_search_pending_ = false;
       this->release_services();
       this->set_state(espbt::ClientState::IDLE);
       break;
     }
+    case ESP_GATTC_DIS_SRVC_CMPL_EVT: {
+      if (param->dis_srvc_cmpl.conn_id != this->conn_id_)
+        return false;
+      ESP_LOGV(TAG, "[%d] [%s] ESP_GATTC_DIS_SRVC_CMPL_EVT, status %d", this->connection_index_,
+               this->address_str_.c_str(), param->dis_srvc_cmpl.status);
+      if (this->services_from_cache_ && this->state_ == espbt::ClientState::CONNECTED)
+        this->cached_search_pending_ = true;
+      break;
+    }
     case ESP_GATTC_SEARCH_RES_EVT: {
       this->service_count_++;
       if (this->connection_type_ == espbt::ConnectionType::V3_WITHOUT_CACHE) {
@@ -187,17 +230,31 @@ bool BLEClientBase::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_
     }
     case ESP_GATTC_SEARCH_CMPL_EVT: {
       ESP_LOGV(TAG, "[%d] [%s] ESP_GATTC_SEARCH_CMPL_EVT", this->connection_index_, this->address_str_.c_str());
+      if (!this->services_from_cache_)
+        this->update_cached_database_();
       for (auto &svc : this->services_) {
         ESP_LOGV(TAG, "[%d] [%s] Service UUID: %s", this->connection_index_, this->address_str_.c_str(),
                  svc->uuid.to_string().c_str());
         ESP_LOGV(TAG, "[%d] [%s]  start_handle: 0x%x  end_handle: 0x%x", this->connection_index_,
                  this->address_str_.c_str(), svc->start_handle, svc->end_handle);
       }
-      ESP_LOGI(TAG, "[%d] [%s] Connected", this->connection_index_, this->address_str_.c_str());
+      ESP_LOGI(TAG, "[%d] [%s] Connected in %" PRIu32 " ms", this->connection_index_, this->address_str_.c_str(),
+               millis() - this->connect_started_);
       this->set_state(espbt::ClientState::CONNECTED);
       this->state_ = espbt::ClientState::ESTABLISHED;
       break;
     }
+    case ESP_GATTC_SRVC_CHG_EVT: {
+      if (memcmp(param->srvc_chg.remote_bda, this->remote_bda_, 6) != 0)
+        return false;
+      ESP_LOGI(TAG, "[%d] [%s] GATT database changed", this->connection_index_, this->address_str_.c_str());
+      global_gatt_cache.invalidate(this->address_);
+      if (this->services_from_cache_) {
+        // The handles of the services built from the cache may be stale now, discover them again on reconnect.
+        this->disconnect();
+      }
+      break;
+    }
     case ESP_GATTC_REG_FOR_NOTIFY_EVT: {
       if (this->connection_type_ == espbt::ConnectionType::V3_WITH_CACHE ||
           this->connection_type_ == espbt::ConnectionType::V3_WITHOUT_CACHE) {
@@ -205,33 +262,44 @@ bool BLEClientBase::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_
         // when using the cache
         break;
       }
-      esp_gattc_descr_elem_t desc_result;
-      uint16_t count = 1;
-      esp_gatt_status_t descr_status =
-          esp_ble_gattc_get_descr_by_char_handle(this->gattc_if_, this->connection_index_, param->reg_for_notify.handle,
-                                                 NOTIFY_DESC_UUID, &desc_result, &count);
-      if (descr_status != ESP_GATT_OK) {
-        ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_get_descr_by_char_handle error, status=%d", this->connection_index_,
-                 this->address_str_.c_str(), descr_status);
-        break;
-      }
-      esp_gattc_char_elem_t char_result;
-      esp_gatt_status_t char_status =
-          esp_ble_gattc_get_all_char(this->gattc_if_, this->connection_index_, param->reg_for_notify.handle,
-                                     param->reg_for_notify.handle, &char_result, &count, 0);
-      if (char_status != ESP_GATT_OK) {
-        ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_get_all_char error, status=%d", this->connection_index_,
-                 this->address_str_.c_str(), char_status);
-        break;
+      uint16_t descr_handle;
+      esp_gatt_char_prop_t properties;
+      auto *descr = this->get_config_descriptor(param->reg_for_notify.handle);
+      if (descr != nullptr) {
+        descr_handle = descr->handle;
+        properties = descr->characteristic->properties;
+      } else {
+        // The services may already have been released, look the handles up in Bluedroid's database.
+        esp_gattc_descr_elem_t desc_result;
+        uint16_t count = 1;
+        esp_gatt_status_t descr_status =
+            esp_ble_gattc_get_descr_by_char_handle(this->gattc_if_, this->conn_id_, param->reg_for_notify.handle,
+                                                   NOTIFY_DESC_UUID, &desc_result, &count);
+        if (descr_status != ESP_GATT_OK) {
+          ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_get_descr_by_char_handle error, status=%d", this->connection_index_,
+                   this->address_str_.c_str(), descr_status);
+          break;
+        }
+        esp_gattc_char_elem_t char_result;
+        esp_gatt_status_t char_status =
+            esp_ble_gattc_get_all_char(this->gattc_if_, this->conn_id_, param->reg_for_notify.handle,
+                                       param->reg_for_notify.handle, &char_result, &count, 0);
+        if (char_status != ESP_GATT_OK) {
+          ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_get_all_char error, status=%d", this->connection_index_,
+                   this->address_str_.c_str(), char_status);
+          break;
+        }
+        descr_handle = desc_result.handle;
+        properties = char_result.properties;
       }
 
       /*
         1 = notify
         2 = indicate
       */
-      uint16_t notify_en = char_result.properties & ESP_GATT_CHAR_PROP_BIT_NOTIFY ? 1 : 2;
+      uint16_t notify_en = properties & ESP_GATT_CHAR_PROP_BIT_NOTIFY ? 1 : 2;
       esp_err_t status =
-          esp_ble_gattc_write_char_descr(this->gattc_if_, this->conn_id_, desc_result.handle, sizeof(notify_en),
+          esp_ble_gattc_write_char_descr(this->gattc_if_, this->conn_id_, descr_handle, sizeof(notify_en),
                                          (uint8_t *) &notify_en, ESP_GATT_WRITE_TYPE_RSP, ESP_GATT_AUTH_REQ_NONE);
       if (status) {
         ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_write_char_descr error, status=%d", this->connection_index_,
@@ -246,6 +314,128 @@ bool BLEClientBase::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_
   return true;
 }
 
+static GATTAttribute make_attribute(GATTAttributeType type, const esp_bt_uuid_t &uuid, uint16_t handle,
+                                   uint16_t end_handle = 0, uint8_t properties = 0) {
+  // Zero the unused bytes of the uuid so equal databases hash equally
+  GATTAttribute attribute{};
+  attribute.uuid.len = uuid.len;
+  memcpy(attribute.uuid.uuid.uuid128, uuid.uuid.uuid128, std::min<size_t>(uuid.len, ESP_UUID_LEN_128));
+  attribute.handle = handle;
+  attribute.end_handle = end_handle;
+  attribute.type = type;
+  attribute.properties = properties;
+  return attribute;
+}
+
+void BLEClientBase::load_cached_database_(const GATTDatabase &database) {
+  this->services_from_cache_ = true;
+  BLEService *service = nullptr;
+  BLECharacteristic *characteristic = nullptr;
+  for (const auto &attribute : database) {
+    switch (attribute.type) {
+      case GATT_ATTRIBUTE_SERVICE:
+        this->service_count_++;
+        service = nullptr;
+        characteristic = nullptr;
+        if (this->connection_type_ == espbt::ConnectionType::V3_WITHOUT_CACHE) {
+          // V3 clients only need the service count, the proxy sends them the cached database.
+          break;
+        }
+        service = new BLEService();  // NOLINT(cppcoreguidelines-owning-memory)
+        service->uuid = espbt::ESPBTUUID::from_uuid(attribute.uuid);
+        service->start_handle = attribute.handle;
+        service->end_handle = attribute.end_handle;
+        service->client = this;
+        service->parsed = true;
+        this->services_.push_back(service);
+        break;
+      case GATT_ATTRIBUTE_CHARACTERISTIC:
+        characteristic = nullptr;
+        if (service == nullptr)
+          break;
+        characteristic = new BLECharacteristic();  // NOLINT(cppcoreguidelines-owning-memory)
+        characteristic->uuid = espbt::ESPBTUUID::from_uuid(attribute.uuid);
+        characteristic->handle = attribute.handle;
+        characteristic->properties = (esp_gatt_char_prop_t) attribute.properties;
+        characteristic->service = service;
+        characteristic->parsed = true;
+        service->characteristics.push_back(characteristic);
+        break;
+      case GATT_ATTRIBUTE_DESCRIPTOR: {
+        if (characteristic == nullptr)
+          break;
+        auto *descriptor = new BLEDescriptor();  // NOLINT(cppcoreguidelines-owning-memory)
+        descriptor->uuid = espbt::ESPBTUUID::from_uuid(attribute.uuid);
+        descriptor->handle = attribute.handle;
+        descriptor->characteristic = characteristic;
+        characteristic->descriptors.push_back(descriptor);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+void BLEClientBase::update_cached_database_() {
+  GATTDatabase database;
+  uint16_t service_offset = 0;
+  esp_gattc_service_elem_t service_result;
+  while (true) {  // services
+    uint16_t count = 1;
+    esp_gatt_status_t status = esp_ble_gattc_get_service(this->gattc_if_, this->conn_id_, nullptr, &service_result,
+                                                         &count, service_offset++);
+    if (status == ESP_GATT_INVALID_OFFSET || status == ESP_GATT_NOT_FOUND || (status == ESP_GATT_OK && count == 0))
+      break;
+    if (status != ESP_GATT_OK) {
+      ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_get_service error, status=%d", this->connection_index_,
+               this->address_str_.c_str(), status);
+      return;
+    }
+    database.push_back(make_attribute(GATT_ATTRIBUTE_SERVICE, service_result.uuid, service_result.start_handle,
+                                      service_result.end_handle));
+    uint16_t char_offset = 0;
+    esp_gattc_char_elem_t char_result;
+    while (true) {  // characteristics
+      count = 1;
+      status = esp_ble_gattc_get_all_char(this->gattc_if_, this->conn_id_, service_result.start_handle,
+                                          service_result.end_handle, &char_result, &count, char_offset++);
+      if (status == ESP_GATT_INVALID_OFFSET || status == ESP_GATT_NOT_FOUND || (status == ESP_GATT_OK && count == 0))
+        break;
+      if (status != ESP_GATT_OK) {
+        ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_get_all_char error, status=%d", this->connection_index_,
+                 this->address_str_.c_str(), status);
+        return;
+      }
+      database.push_back(make_attribute(GATT_ATTRIBUTE_CHARACTERISTIC, char_result.uuid, char_result.char_handle, 0,
+                                        char_result.properties));
+      uint16_t desc_offset = 0;
+      esp_gattc_descr_elem_t desc_result;
+      while (true) {  // descriptors
+        count = 1;
+        status = esp_ble_gattc_get_all_descr(this->gattc_if_, this->conn_id_, char_result.char_handle, &desc_result,
+                                             &count, desc_offset++);
+        if (status == ESP_GATT_INVALID_OFFSET || status == ESP_GATT_NOT_FOUND || (status == ESP_GATT_OK && count == 0))
+          break;
+        if (status != ESP_GATT_OK) {
+          ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_get_all_descr error, status=%d", this->connection_index_,
+                   this->address_str_.c_str(), status);
+          return;
+        }
+        database.push_back(make_attribute(GATT_ATTRIBUTE_DESCRIPTOR, desc_result.uuid, desc_result.handle));
+      }
+    }
+  }
+  if (database.empty())
+    return;
+
+  ESP_LOGD(TAG, "[%d] [%s] Cached GATT database with %u attributes", this->connection_index_,
+           this->address_str_.c_str(), (unsigned) database.size());
+  if (this->persist_gatt_database_)
+    global_gatt_cache.persist(this->address_);
+  global_gatt_cache.put(this->address_, std::move(database));
+}
+
 void BLEClientBase::gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
   switch (event) {
     // This event is sent by the server when it requests security
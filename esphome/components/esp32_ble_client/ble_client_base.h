@@ -5,6 +5,7 @@
 #include "esphome/components/esp32_ble_tracker/esp32_ble_tracker.h"
 #include "esphome/core/component.h"
 
+#include "ble_gatt_cache.h"
 #include "ble_service.h"
 
 #include <array>
@@ -28,6 +29,7 @@ class BLEClientBase : public espbt::ESPBTClient, public Component {
   float get_setup_priority() const override;
 
   bool parse_device(const espbt::ESPBTDevice &device) override;
+  bool accepts_address(uint64_t address) const override { return this->address_ != 0 && address == this->address_; }
   void on_scan_end() override {}
   bool gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                            esp_ble_gattc_cb_param_t *param) override;
@@ -53,6 +55,8 @@ class BLEClientBase : public espbt::ESPBTClient, public Component {
     }
   }
   std::string address_str() const { return this->address_str_; }
+  /// Keep the GATT database of the peer across reboots. Only meant for clients that stay with one peer.
+  void set_persist_gatt_database(bool persist) { this->persist_gatt_database_ = persist; }
 
   BLEService *get_service(espbt::ESPBTUUID uuid);
   BLEService *get_service(uint16_t uuid);
@@ -93,6 +97,16 @@ class BLEClientBase : public espbt::ESPBTClient, public Component {
   espbt::ConnectionType connection_type_{espbt::ConnectionType::V1};
 
   std::vector<BLEService *> services_;
+
+  /// Build the services of the connection from a cached database instead of running service discovery.
+  void load_cached_database_(const GATTDatabase &database);
+  /// Store the database Bluedroid discovered in the cache.
+  void update_cached_database_();
+
+  bool services_from_cache_{false};
+  bool cached_search_pending_{false};
+  bool persist_gatt_database_{false};
+  uint32_t connect_started_{0};
 };
 
 }  // namespace esp32_ble_client
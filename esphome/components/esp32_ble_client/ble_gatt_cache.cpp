@@ -0,0 +1,106 @@
+#include "ble_gatt_cache.h"
+
+#include <cstring>
+
+#ifdef USE_ESP32
+
+namespace esphome {
+namespace esp32_ble_client {
+
+const GATTDatabase *GATTCache::get(uint64_t address) const {
+  for (const auto &entry : this->entries_) {
+    if (entry.address == address)
+      return &entry.database;
+  }
+  return nullptr;
+}
+
+void GATTCache::put(uint64_t address, GATTDatabase &&database) {
+  auto *peer = this->get_persisted_(address);
+  if (peer != nullptr)
+    this->save_(*peer, database);
+  for (auto it = this->entries_.begin(); it != this->entries_.end(); ++it) {
+    if (it->address == address) {
+      this->entries_.erase(it);
+      break;
+    }
+  }
+  if (this->entries_.size() >= MAX_ENTRIES)
+    this->entries_.erase(this->entries_.begin());
+  this->entries_.push_back(Entry{address, std::move(database)});
+}
+
+void GATTCache::invalidate(uint64_t address) {
+  for (auto it = this->entries_.begin(); it != this->entries_.end(); ++it) {
+    if (it->address == address) {
+      this->entries_.erase(it);
+      break;
+    }
+  }
+  auto *peer = this->get_persisted_(address);
+  if (peer != nullptr && peer->saved_hash != 0) {
+    auto saved = make_unique<SavedGATTDatabase>();
+    peer->pref.save(saved.get());
+    peer->saved_hash = 0;
+  }
+}
+
+void GATTCache::persist(uint64_t address) {
+  if (address == 0 || this->get_persisted_(address) != nullptr)
+    return;
+  PersistedPeer peer{address, {}, 0};
+  peer.pref = global_preferences->make_preference<SavedGATTDatabase>(
+      fnv1_hash("esp32_ble_client_gatt_" + to_string(address)), true);
+  auto saved = make_unique<SavedGATTDatabase>();
+  if (peer.pref.load(saved.get()) && saved->address == address && saved->count <= MAX_PERSISTED_GATT_ATTRIBUTES) {
+    GATTDatabase database(saved->attributes, saved->attributes + saved->count);
+    if (hash(database) == saved->hash) {
+      peer.saved_hash = saved->hash;
+      this->persisted_.push_back(peer);
+      this->put(address, std::move(database));
+      return;
+    }
+  }
+  this->persisted_.push_back(peer);
+}
+
+GATTCache::PersistedPeer *GATTCache::get_persisted_(uint64_t address) {
+  for (auto &peer : this->persisted_) {
+    if (peer.address == address)
+      return &peer;
+  }
+  return nullptr;
+}
+
+void GATTCache::save_(PersistedPeer &peer, const GATTDatabase &database) {
+  if (database.empty() || database.size() > MAX_PERSISTED_GATT_ATTRIBUTES)
+    return;
+  const uint32_t database_hash = hash(database);
+  if (database_hash == peer.saved_hash)
+    return;
+  auto saved = make_unique<SavedGATTDatabase>();
+  saved->address = peer.address;
+  saved->hash = database_hash;
+  saved->count = database.size();
+  memcpy(saved->attributes, database.data(), database.size() * sizeof(GATTAttribute));
+  if (peer.pref.save(saved.get()))
+    peer.saved_hash = database_hash;
+}
+
+uint32_t GATTCache::hash(const GATTDatabase &database) {
+  // FNV-1 over the raw attributes
+  uint32_t hash = 2166136261UL;
+  const auto *data = reinterpret_cast<const uint8_t *>(database.data());
+  for (size_t i = 0; i < database.size() * sizeof(GATTAttribute); i++) {
+    hash *= 16777619UL;
+    hash ^= data[i];
+  }
+  return hash;
+}
+
+GATTCache global_gatt_cache;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace esp32_ble_client
+}  // namespace esphome
+
+#endif  // USE_ESP32
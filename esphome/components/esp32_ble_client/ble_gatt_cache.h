@@ -0,0 +1,94 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <esp_bt_defs.h>
+#include <esp_gatt_defs.h>
+
+namespace esphome {
+namespace esp32_ble_client {
+
+enum GATTAttributeType : uint8_t {
+  GATT_ATTRIBUTE_SERVICE = 0,
+  GATT_ATTRIBUTE_CHARACTERISTIC = 1,
+  GATT_ATTRIBUTE_DESCRIPTOR = 2,
+};
+
+/// One entry of a discovered GATT database. A database is a flat list in discovery order: every service is
+/// followed by its characteristics, and every characteristic by its descriptors.
+struct GATTAttribute {
+  esp_bt_uuid_t uuid;
+  uint16_t handle;
+  /// Last handle of a service, unused for characteristics and descriptors.
+  uint16_t end_handle;
+  uint8_t type;
+  /// Characteristic properties, unused for services and descriptors.
+  uint8_t properties;
+} PACKED;  // NOLINT
+
+using GATTDatabase = std::vector<GATTAttribute>;
+
+/// Databases larger than this are kept in RAM but not persisted.
+static const uint16_t MAX_PERSISTED_GATT_ATTRIBUTES = 64;
+
+/// The layout the database of a persisted peer is stored in.
+struct SavedGATTDatabase {
+  uint64_t address;
+  uint32_t hash;
+  uint16_t count;
+  GATTAttribute attributes[MAX_PERSISTED_GATT_ATTRIBUTES];
+} PACKED;  // NOLINT
+
+/** Discovered GATT databases of recently connected peers, keyed by address.
+ *
+ * Shared by all clients so a peer that reconnects through a different connection slot still skips service
+ * discovery. Holds a bounded number of peers and evicts the oldest entry when full.
+ *
+ * The databases of peers registered with persist() are also kept in flash, one entry per address, and rewritten
+ * only when the database of that peer changes. This is meant for clients with a fixed address; connection slots
+ * that move between peers would rewrite flash on nearly every connection.
+ */
+class GATTCache {
+ public:
+  static const size_t MAX_ENTRIES = 8;
+
+  /// The cached database of the peer, or nullptr.
+  const GATTDatabase *get(uint64_t address) const;
+  void put(uint64_t address, GATTDatabase &&database);
+  /// Forget the database of the peer, also the persisted one.
+  void invalidate(uint64_t address);
+  /// Keep the database of the peer across reboots, and load the one saved before into the cache.
+  void persist(uint64_t address);
+
+  static uint32_t hash(const GATTDatabase &database);
+
+ protected:
+  struct Entry {
+    uint64_t address;
+    GATTDatabase database;
+  };
+  struct PersistedPeer {
+    uint64_t address;
+    ESPPreferenceObject pref;
+    /// Hash of the saved database, 0 if none is saved.
+    uint32_t saved_hash;
+  };
+  PersistedPeer *get_persisted_(uint64_t address);
+  void save_(PersistedPeer &peer, const GATTDatabase &database);
+
+  std::vector<Entry> entries_;
+  std::vector<PersistedPeer> persisted_;
+};
+
+extern GATTCache global_gatt_cache;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace esp32_ble_client
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,80 @@
+#include "address_set.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+AddressSet::~AddressSet() {
+  if (this->slots_ != nullptr)
+    ExternalRAMAllocator<uint64_t>().deallocate(this->slots_, this->capacity_);
+}
+bool AddressSet::insert(uint64_t address) {
+  if (address == 0)
+    return true;
+  if (this->slots_ == nullptr && !this->resize_(6))
+    return true;
+  if (this->contains(address))
+    return false;
+  if (this->size_ >= this->capacity_ / 4 * 3) {
+    if (this->capacity_ < this->max_capacity_ && !this->resize_(this->bits_ + 1))
+      this->max_capacity_ = this->capacity_;
+    if (this->size_ >= this->capacity_ / 4 * 3)
+      this->clear();
+  }
+  const size_t mask = this->capacity_ - 1;
+  size_t i = this->slot_(address);
+  while (this->slots_[i] != 0)
+    i = (i + 1) & mask;
+  this->slots_[i] = address;
+  this->size_++;
+  return true;
+}
+bool AddressSet::resize_(uint8_t bits) {
+  const size_t capacity = size_t(1) << bits;
+  ExternalRAMAllocator<uint64_t> allocator(
+      capacity > this->max_internal_capacity_
+          ? ExternalRAMAllocator<uint64_t>::Flags(ExternalRAMAllocator<uint64_t>::REFUSE_INTERNAL |
+                                                  ExternalRAMAllocator<uint64_t>::ALLOW_FAILURE)
+          : ExternalRAMAllocator<uint64_t>::ALLOW_FAILURE);
+  uint64_t *slots = allocator.allocate(capacity);
+  if (slots == nullptr)
+    return false;
+  std::fill(slots, slots + capacity, 0);
+  const size_t mask = capacity - 1;
+  uint64_t *old = this->slots_;
+  const size_t old_capacity = this->capacity_;
+  this->slots_ = slots;
+  this->capacity_ = capacity;
+  this->bits_ = bits;
+  for (size_t j = 0; j < old_capacity; j++) {
+    if (old[j] == 0)
+      continue;
+    size_t i = this->slot_(old[j]);
+    while (this->slots_[i] != 0)
+      i = (i + 1) & mask;
+    this->slots_[i] = old[j];
+  }
+  if (old != nullptr)
+    allocator.deallocate(old, old_capacity);
+  return true;
+}
+bool AddressSet::contains(uint64_t address) const {
+  if (this->size_ == 0)
+    return false;
+  const size_t mask = this->capacity_ - 1;
+  for (size_t i = this->slot_(address); this->slots_[i] != 0; i = (i + 1) & mask) {
+    if (this->slots_[i] == address)
+      return true;
+  }
+  return false;
+}
+void AddressSet::clear() {
+  if (this->size_ == 0)
+    return;
+  std::fill(this->slots_, this->slots_ + this->capacity_, 0);
+  this->size_ = 0;
+}
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace esp32_ble_tracker {
+
+/** A set of BLE addresses with a bounded number of slots, for listeners that need to know whether a device was
+ * seen before.
+ *
+ * Open addressing with linear probing. The table starts small, preferably in external RAM, and doubles when it is
+ * three quarters full until it has max_capacity slots. When even that is three quarters full the set forgets all
+ * addresses and starts over, so lookups stay fast and memory stays bounded however many devices are around.
+ * Address 0 is never stored.
+ *
+ * Tables with more than max_internal_capacity slots are only allocated in external RAM. Without it, or when an
+ * allocation fails, the table keeps its size from then on.
+ */
+class AddressSet {
+ public:
+  /// Both capacities have to be powers of two.
+  explicit AddressSet(size_t max_capacity, size_t max_internal_capacity = 1024)
+      : max_capacity_(max_capacity), max_internal_capacity_(max_internal_capacity) {}
+  AddressSet(const AddressSet &) = delete;
+  AddressSet &operator=(const AddressSet &) = delete;
+  ~AddressSet();
+
+  /// Add an address, returns false if it was in the set already.
+  bool insert(uint64_t address);
+  bool contains(uint64_t address) const;
+  /// Forget all addresses, keeping the table.
+  void clear();
+  size_t size() const { return this->size_; }
+  size_t capacity() const { return this->capacity_; }
+
+ protected:
+  size_t slot_(uint64_t address) const {
+    // Fibonacci hashing, the upper bits of the product depend on all bytes of the address
+    return (address * 0x9E3779B97F4A7C15ULL) >> (64 - this->bits_);
+  }
+  /// Returns false if the larger table couldn't be allocated, the current one is kept then.
+  bool resize_(uint8_t bits);
+
+  size_t max_capacity_;
+  size_t max_internal_capacity_;
+  uint8_t bits_{0};
+  size_t size_{0};
+  size_t capacity_{0};
+  uint64_t *slots_{nullptr};
+};
+
+}  // namespace esp32_ble_tracker
+}  // namespace esphome
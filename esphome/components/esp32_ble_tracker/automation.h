@@ -11,6 +11,7 @@ class ESPBTAdvertiseTrigger : public Trigger<const ESPBTDevice &>, public ESPBTD
  public:
   explicit ESPBTAdvertiseTrigger(ESP32BLETracker *parent) { parent->register_listener(this); }
   void set_addresses(const std::vector<uint64_t> &addresses) { this->address_vec_ = addresses; }
+  std::vector<uint64_t> get_address_filter() const override { return this->address_vec_; }
 
   bool parse_device(const ESPBTDevice &device) override {
     uint64_t u64_addr = device.address_uint64();
@@ -36,6 +37,12 @@ class BLEServiceDataAdvertiseTrigger : public Trigger<const adv_data_t &>, publi
   void set_service_uuid32(uint32_t uuid) { this->uuid_ = ESPBTUUID::from_uint32(uuid); }
   void set_service_uuid128(uint8_t *uuid) { this->uuid_ = ESPBTUUID::from_raw(uuid); }
 
+  std::vector<uint64_t> get_address_filter() const override {
+    if (this->address_)
+      return {this->address_};
+    return {};
+  }
+  std::vector<ESPBTUUID> get_service_uuid_filter() const override { return {this->uuid_}; }
   bool parse_device(const ESPBTDevice &device) override {
     if (this->address_ && device.address_uint64() != this->address_) {
       return false;
@@ -62,6 +69,11 @@ class BLEManufacturerDataAdvertiseTrigger : public Trigger<const adv_data_t &>,
   void set_manufacturer_uuid32(uint32_t uuid) { this->uuid_ = ESPBTUUID::from_uint32(uuid); }
   void set_manufacturer_uuid128(uint8_t *uuid) { this->uuid_ = ESPBTUUID::from_raw(uuid); }
 
+  std::vector<uint64_t> get_address_filter() const override {
+    if (this->address_)
+      return {this->address_};
+    return {};
+  }
   bool parse_device(const ESPBTDevice &device) override {
     if (this->address_ && device.address_uint64() != this->address_) {
       return false;
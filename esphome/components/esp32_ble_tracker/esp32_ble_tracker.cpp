@@ -7,6 +7,9 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 #include <esp_bt.h>
 #include <esp_bt_defs.h>
 #include <esp_bt_main.h>
@@ -44,11 +47,14 @@ void ESP32BLETracker::setup() {
   }
   ExternalRAMAllocator<esp_ble_gap_cb_param_t::ble_scan_result_evt_param> allocator(
       ExternalRAMAllocator<esp_ble_gap_cb_param_t::ble_scan_result_evt_param>::ALLOW_FAILURE);
-  this->scan_result_buffer_ = allocator.allocate(ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE);
+  // double buffered: the GAP callback fills one half while the loop processes the other
+  this->scan_result_buffer_ = allocator.allocate(ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE * 2);
 
   if (this->scan_result_buffer_ == nullptr) {
     ESP_LOGE(TAG, "Could not allocate buffer for BLE Tracker!");
     this->mark_failed();
+  } else {
+    this->scan_result_ready_buffer_ = this->scan_result_buffer_ + ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE;
   }
 
   global_esp32_ble_tracker = this;
@@ -56,6 +62,15 @@ void ESP32BLETracker::setup() {
   this->scan_end_lock_ = xSemaphoreCreateMutex();
   this->scanner_idle_ = true;
 
+#ifdef USE_SENSOR
+  if (this->dropped_advertisements_sensor_ != nullptr) {
+    this->set_interval("dropped_advertisements", 60000, [this]() {
+      this->dropped_advertisements_sensor_->publish_state(this->dropped_advertisements_);
+      this->dropped_advertisements_ = 0;
+    });
+  }
+#endif
+
 #ifdef USE_OTA
   ota::global_ota_component->add_on_state_callback([this](ota::OTAState state, float progress, uint8_t error) {
     if (state == ota::OTA_STARTED) {
@@ -78,6 +93,7 @@ void ESP32BLETracker::loop() {
   int discovered = 0;
   int searching = 0;
   int disconnecting = 0;
+  ESPBTClient *longest_waiting = nullptr;
   for (auto *client : this->clients_) {
     switch (client->state()) {
       case ClientState::DISCONNECTING:
@@ -85,6 +101,9 @@ void ESP32BLETracker::loop() {
         break;
       case ClientState::DISCOVERED:
         discovered++;
+        if (longest_waiting == nullptr ||
+            (int32_t) (client->get_discovered_at() - longest_waiting->get_discovered_at()) < 0)
+          longest_waiting = client;
         break;
       case ClientState::SEARCHING:
         searching++;
@@ -102,47 +121,37 @@ void ESP32BLETracker::loop() {
   if (!this->scanner_idle_) {
     if (this->scan_result_index_ &&  // if it looks like we have a scan result we will take the lock
         xSemaphoreTake(this->scan_result_lock_, 5L / portTICK_PERIOD_MS)) {
-      uint32_t index = this->scan_result_index_;
-      if (index >= ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE) {
-        ESP_LOGW(TAG, "Too many BLE events to process. Some devices may not show up.");
+      // swap the buffers and process the results without holding the lock, so the GAP callback can keep adding
+      std::swap(this->scan_result_buffer_, this->scan_result_ready_buffer_);
+      const size_t index = this->scan_result_index_;
+      const uint32_t dropped = this->scan_result_dropped_;
+      this->scan_result_index_ = 0;
+      this->scan_result_dropped_ = 0;
+      xSemaphoreGive(this->scan_result_lock_);
+
+      if (dropped != 0) {
+        ESP_LOGW(TAG, "Too many BLE events to process, dropped %" PRIu32 ". Some devices may not show up.", dropped);
+        this->dropped_advertisements_ += dropped;
       }
 
+      auto *results = this->scan_result_ready_buffer_;
       bool bulk_parsed = false;
 
       for (auto *listener : this->listeners_) {
-        bulk_parsed |= listener->parse_devices(this->scan_result_buffer_, this->scan_result_index_);
+        bulk_parsed |= listener->parse_devices(results, index);
       }
       for (auto *client : this->clients_) {
-        bulk_parsed |= client->parse_devices(this->scan_result_buffer_, this->scan_result_index_);
+        bulk_parsed |= client->parse_devices(results, index);
       }
 
       if (!bulk_parsed) {
+        if (!this->listener_index_valid_)
+          this->index_listeners_();
         for (size_t i = 0; i < index; i++) {
-          ESPBTDevice device;
-          device.parse_scan_rst(this->scan_result_buffer_[i]);
-
-          bool found = false;
-          for (auto *listener : this->listeners_) {
-            if (listener->parse_device(device))
-              found = true;
-          }
-
-          for (auto *client : this->clients_) {
-            if (client->parse_device(device)) {
-              found = true;
-              if (!connecting && client->state() == ClientState::DISCOVERED) {
-                promote_to_connecting = true;
-              }
-            }
-          }
-
-          if (!found && !this->scan_continuous_) {
-            this->print_bt_device_info(device);
-          }
+          if (this->dispatch_scan_result_(results[i], connecting))
+            promote_to_connecting = true;
         }
       }
-      this->scan_result_index_ = 0;
-      xSemaphoreGive(this->scan_result_lock_);
     }
 
     /*
@@ -198,23 +207,29 @@ void ESP32BLETracker::loop() {
   // If there is a discovered client and no connecting
   // clients and no clients using the scanner to search for
   // devices, then stop scanning and promote the discovered
-  // client to ready to connect.
+  // client that has been waiting the longest to ready to connect.
   if (promote_to_connecting) {
-    for (auto *client : this->clients_) {
-      if (client->state() == ClientState::DISCOVERED) {
-        if (xSemaphoreTake(this->scan_end_lock_, 0L)) {
-          // Scanner is not running since we got the
-          // lock, so we can promote the client.
-          xSemaphoreGive(this->scan_end_lock_);
-          // We only want to promote one client at a time.
-          // once the scanner is fully stopped.
-          client->set_state(ClientState::READY_TO_CONNECT);
-        } else {
-          ESP_LOGD(TAG, "Pausing scan to make connection...");
-          esp_ble_gap_stop_scanning();
-          this->cancel_timeout("scan");
+    if (longest_waiting == nullptr) {
+      // discovered while dispatching the scan results above
+      for (auto *client : this->clients_) {
+        if (client->state() == ClientState::DISCOVERED) {
+          longest_waiting = client;
+          break;
         }
-        break;
+      }
+    }
+    if (longest_waiting != nullptr) {
+      if (xSemaphoreTake(this->scan_end_lock_, 0L)) {
+        // Scanner is not running since we got the
+        // lock, so we can promote the client.
+        xSemaphoreGive(this->scan_end_lock_);
+        // We only want to promote one client at a time.
+        // once the scanner is fully stopped.
+        longest_waiting->set_state(ClientState::READY_TO_CONNECT);
+      } else {
+        ESP_LOGD(TAG, "Pausing scan to make connection...");
+        esp_ble_gap_stop_scanning();
+        this->cancel_timeout("scan");
       }
     }
   }
@@ -281,6 +296,87 @@ void ESP32BLETracker::end_of_scan_() {
     listener->on_scan_end();
 }
 
+void ESP32BLETracker::index_listeners_() {
+  this->address_listeners_.clear();
+  this->service_uuid_listeners_.clear();
+  this->unfiltered_listeners_.clear();
+  for (auto *listener : this->listeners_) {
+    auto addresses = listener->get_address_filter();
+    if (!addresses.empty()) {
+      for (uint64_t address : addresses) {
+        auto &listeners = this->address_listeners_[address];
+        if (listeners.empty() || listeners.back() != listener)
+          listeners.push_back(listener);
+      }
+      continue;
+    }
+    auto uuids = listener->get_service_uuid_filter();
+    if (!uuids.empty()) {
+      for (auto &uuid : uuids)
+        this->service_uuid_listeners_.emplace_back(uuid, listener);
+      continue;
+    }
+    this->unfiltered_listeners_.push_back(listener);
+  }
+  this->listener_index_valid_ = true;
+}
+
+bool ESP32BLETracker::dispatch_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &result,
+                                            bool connecting) {
+  // only the fixed size fields are parsed here, the advertisement data when a listener asks for it
+  ESPBTDevice device;
+  device.parse_scan_rst(result);
+  const uint64_t address = device.address_uint64();
+  auto &interested = this->interested_listeners_;
+  interested.clear();
+  auto it = this->address_listeners_.find(address);
+  if (it != this->address_listeners_.end())
+    interested.insert(interested.end(), it->second.begin(), it->second.end());
+  for (auto &entry : this->service_uuid_listeners_) {
+    // the UUIDs of a listener are next to each other
+    if ((interested.empty() || interested.back() != entry.second) &&
+        (device.has_service_uuid(entry.first) || device.find_service_data(entry.first).has_value()))
+      interested.push_back(entry.second);
+  }
+  bool client_interested = false;
+  for (auto *client : this->clients_) {
+    if (client->accepts_address(address)) {
+      client_interested = true;
+      break;
+    }
+  }
+  // unless the device has to be printed, don't bother with advertisements nobody is interested in
+  if (interested.empty() && this->unfiltered_listeners_.empty() && !client_interested && this->scan_continuous_)
+    return false;
+
+  bool found = false;
+  for (auto *listener : interested) {
+    if (listener->parse_device(device))
+      found = true;
+  }
+  for (auto *listener : this->unfiltered_listeners_) {
+    if (listener->parse_device(device))
+      found = true;
+  }
+
+  bool promote_to_connecting = false;
+  if (client_interested) {
+    for (auto *client : this->clients_) {
+      if (client->accepts_address(address) && client->parse_device(device)) {
+        found = true;
+        if (!connecting && client->state() == ClientState::DISCOVERED) {
+          promote_to_connecting = true;
+        }
+      }
+    }
+  }
+
+  if (!found && !this->scan_continuous_) {
+    this->print_bt_device_info(device);
+  }
+  return promote_to_connecting;
+}
+
 void ESP32BLETracker::register_client(ESPBTClient *client) {
   client->app_id = ++this->app_id_;
   this->clients_.push_back(client);
@@ -328,9 +424,12 @@ void ESP32BLETracker::gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_
 
 void ESP32BLETracker::gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
   if (param.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
-    if (xSemaphoreTake(this->scan_result_lock_, 0L)) {
+    // the loop only holds the lock to swap the buffers, so this doesn't wait long
+    if (xSemaphoreTake(this->scan_result_lock_, portMAX_DELAY)) {
       if (this->scan_result_index_ < ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE) {
         this->scan_result_buffer_[this->scan_result_index_++] = param;
+      } else {
+        this->scan_result_dropped_++;
       }
       xSemaphoreGive(this->scan_result_lock_);
     }
@@ -355,6 +454,85 @@ optional<ESPBLEiBeacon> ESPBLEiBeacon::from_manufacturer_data(const ServiceData
     return {};
   return ESPBLEiBeacon(data.data.data());
 }
+optional<ESPBLEiBeacon> ESPBLEiBeacon::from_manufacturer_data(const ServiceDataView &data) {
+  if (!data.uuid.contains(0x4C, 0x00))
+    return {};
+
+  if (data.size != 23)
+    return {};
+  return ESPBLEiBeacon(data.data);
+}
+
+void AdvRecordIterator::find_record_(size_t offset) {
+  while (offset + 2 < this->len_) {
+    const uint8_t field_length = this->payload_[offset];
+    if (field_length == 0) {
+      offset++;  // Possible zero padded advertisement data
+      continue;
+    }
+    this->offset_ = offset;
+    // first byte of adv record is adv record type
+    this->record_.type = this->payload_[offset + 1];
+    this->record_.data = &this->payload_[offset + 2];
+    this->record_.length = std::min<size_t>(field_length - 1, this->len_ - offset - 2);
+    return;
+  }
+  this->offset_ = this->len_;
+}
+
+bool AdvRecord::lists_service_uuid(const ESPBTUUID &uuid) const {
+  switch (this->type) {
+    case ESP_BLE_AD_TYPE_16SRV_CMPL:
+    case ESP_BLE_AD_TYPE_16SRV_PART:
+      for (uint8_t i = 0; i + 2 <= this->length; i += 2) {
+        if (ESPBTUUID::from_uint16(encode_uint16(this->data[i + 1], this->data[i])) == uuid)
+          return true;
+      }
+      return false;
+    case ESP_BLE_AD_TYPE_32SRV_CMPL:
+    case ESP_BLE_AD_TYPE_32SRV_PART:
+      for (uint8_t i = 0; i + 4 <= this->length; i += 4) {
+        const uint8_t *d = this->data + i;
+        if (ESPBTUUID::from_uint32(encode_uint32(d[3], d[2], d[1], d[0])) == uuid)
+          return true;
+      }
+      return false;
+    case ESP_BLE_AD_TYPE_128SRV_CMPL:
+    case ESP_BLE_AD_TYPE_128SRV_PART:
+      return this->length >= 16 && ESPBTUUID::from_raw(this->data) == uuid;
+    default:
+      return false;
+  }
+}
+
+optional<ServiceDataView> AdvRecord::get_service_data() const {
+  switch (this->type) {
+    case ESP_BLE_AD_TYPE_SERVICE_DATA:
+      if (this->length < 2)
+        return {};
+      return ServiceDataView{ESPBTUUID::from_uint16(encode_uint16(this->data[1], this->data[0])), this->data + 2,
+                             static_cast<uint8_t>(this->length - 2)};
+    case ESP_BLE_AD_TYPE_32SERVICE_DATA:
+      if (this->length < 4)
+        return {};
+      return ServiceDataView{
+          ESPBTUUID::from_uint32(encode_uint32(this->data[3], this->data[2], this->data[1], this->data[0])),
+          this->data + 4, static_cast<uint8_t>(this->length - 4)};
+    case ESP_BLE_AD_TYPE_128SERVICE_DATA:
+      if (this->length < 16)
+        return {};
+      return ServiceDataView{ESPBTUUID::from_raw(this->data), this->data + 16, static_cast<uint8_t>(this->length - 16)};
+    default:
+      return {};
+  }
+}
+
+optional<ServiceDataView> AdvRecord::get_manufacturer_data() const {
+  if (this->type != ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE || this->length < 2)
+    return {};
+  return ServiceDataView{ESPBTUUID::from_uint16(encode_uint16(this->data[1], this->data[0])), this->data + 2,
+                         static_cast<uint8_t>(this->length - 2)};
+}
 
 void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
   this->scan_result_ = param;
@@ -362,9 +540,10 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
     this->address_[i] = param.bda[i];
   this->address_type_ = param.ble_addr_type;
   this->rssi_ = param.rssi;
-  this->parse_adv_(param);
+  this->adv_parsed_ = false;
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+  this->parse_adv_();
   ESP_LOGVV(TAG, "Parse Result:");
   const char *address_type = "";
   switch (this->address_type_) {
@@ -418,22 +597,46 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
   ESP_LOGVV(TAG, "Adv data: %s", format_hex_pretty(param.ble_adv, param.adv_data_len + param.scan_rsp_len).c_str());
 #endif
 }
-void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
-  size_t offset = 0;
-  const uint8_t *payload = param.ble_adv;
-  uint8_t len = param.adv_data_len + param.scan_rsp_len;
-
-  while (offset + 2 < len) {
-    const uint8_t field_length = payload[offset++];  // First byte is length of adv record
-    if (field_length == 0) {
-      continue;  // Possible zero padded advertisement data
-    }
-
-    // first byte of adv record is adv record type
-    const uint8_t record_type = payload[offset++];
-    const uint8_t *record = &payload[offset];
-    const uint8_t record_length = field_length - 1;
-    offset += record_length;
+bool ESPBTDevice::has_service_uuid(const ESPBTUUID &uuid) const {
+  for (const auto &record : this->get_adv_records()) {
+    if (record.lists_service_uuid(uuid))
+      return true;
+  }
+  return false;
+}
+optional<ServiceDataView> ESPBTDevice::find_service_data(const ESPBTUUID &uuid) const {
+  for (const auto &record : this->get_adv_records()) {
+    auto data = record.get_service_data();
+    if (data.has_value() && data->uuid == uuid)
+      return data;
+  }
+  return {};
+}
+optional<ServiceDataView> ESPBTDevice::find_manufacturer_data(const ESPBTUUID &company) const {
+  for (const auto &record : this->get_adv_records()) {
+    auto data = record.get_manufacturer_data();
+    if (data.has_value() && data->uuid == company)
+      return data;
+  }
+  return {};
+}
+void ESPBTDevice::parse_adv_() const {
+  if (this->adv_parsed_)
+    return;
+  this->adv_parsed_ = true;
+  this->name_.clear();
+  this->tx_powers_.clear();
+  this->appearance_.reset();
+  this->ad_flag_.reset();
+  this->service_uuids_.clear();
+  this->manufacturer_datas_.clear();
+  this->service_datas_.clear();
+
+  const uint8_t *payload = this->scan_result_.ble_adv;
+  for (const auto &adv_record : this->get_adv_records()) {
+    const uint8_t record_type = adv_record.type;
+    const uint8_t *record = adv_record.data;
+    const uint8_t record_length = adv_record.length;
 
     // See also Generic Access Profile Assigned Numbers:
     // https://www.bluetooth.com/specifications/assigned-numbers/generic-access-profile/ See also ADVERTISING AND SCAN
@@ -596,12 +799,8 @@ void ESP32BLETracker::dump_config() {
 }
 
 void ESP32BLETracker::print_bt_device_info(const ESPBTDevice &device) {
-  const uint64_t address = device.address_uint64();
-  for (auto &disc : this->already_discovered_) {
-    if (disc == address)
-      return;
-  }
-  this->already_discovered_.push_back(address);
+  if (!this->already_discovered_.insert(device.address_uint64()))
+    return;
 
   ESP_LOGD(TAG, "Found device %s RSSI=%d", device.address_str().c_str(), device.get_rssi());
 
@@ -2,10 +2,12 @@
 
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 
 #include <array>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #ifdef USE_ESP32
@@ -20,6 +22,12 @@
 #include "esphome/components/esp32_ble/ble.h"
 #include "esphome/components/esp32_ble/ble_uuid.h"
 
+#include "address_set.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
 namespace esphome {
 namespace esp32_ble_tracker {
 
@@ -32,11 +40,70 @@ struct ServiceData {
   adv_data_t data;
 };
 
+/// Service or manufacturer data pointing into the advertisement it was found in, valid as long as that is.
+struct ServiceDataView {
+  ESPBTUUID uuid;
+  const uint8_t *data;
+  uint8_t size;
+};
+
+/// An AD structure of an advertisement, pointing into the raw advertisement data.
+struct AdvRecord {
+  uint8_t type;
+  const uint8_t *data;
+  uint8_t length;
+
+  /// Whether this is a list of service UUIDs that contains uuid.
+  bool lists_service_uuid(const ESPBTUUID &uuid) const;
+  /// The service data of this record, if it is one of the service data types.
+  optional<ServiceDataView> get_service_data() const;
+  /// The manufacturer data of this record, if it is manufacturer specific data.
+  optional<ServiceDataView> get_manufacturer_data() const;
+};
+
+/// Walks the AD structures of raw advertisement data in place.
+class AdvRecordIterator {
+ public:
+  AdvRecordIterator(const uint8_t *payload, uint8_t len, uint8_t offset) : payload_(payload), len_(len) {
+    this->find_record_(offset);
+  }
+  const AdvRecord &operator*() const { return this->record_; }
+  const AdvRecord *operator->() const { return &this->record_; }
+  AdvRecordIterator &operator++() {
+    this->find_record_(this->offset_ + 1 + this->payload_[this->offset_]);
+    return *this;
+  }
+  bool operator==(const AdvRecordIterator &other) const { return this->offset_ == other.offset_; }
+  bool operator!=(const AdvRecordIterator &other) const { return this->offset_ != other.offset_; }
+
+ protected:
+  void find_record_(size_t offset);
+
+  const uint8_t *payload_;
+  uint8_t len_;
+  /// Offset of the length byte of the current record, len_ at the end.
+  uint8_t offset_;
+  AdvRecord record_{};
+};
+
+/// The AD structures of an advertisement and its scan response, for use in range-based for loops.
+class AdvRecords {
+ public:
+  AdvRecords(const uint8_t *payload, uint8_t len) : payload_(payload), len_(len) {}
+  AdvRecordIterator begin() const { return {this->payload_, this->len_, 0}; }
+  AdvRecordIterator end() const { return {this->payload_, this->len_, this->len_}; }
+
+ protected:
+  const uint8_t *payload_;
+  uint8_t len_;
+};
+
 class ESPBLEiBeacon {
  public:
   ESPBLEiBeacon() { memset(&this->beacon_data_, 0, sizeof(this->beacon_data_)); }
   ESPBLEiBeacon(const uint8_t *data);
   static optional<ESPBLEiBeacon> from_manufacturer_data(const ServiceData &data);
+  static optional<ESPBLEiBeacon> from_manufacturer_data(const ServiceDataView &data);
 
   uint16_t get_major() { return ((this->beacon_data_.major & 0xFF) << 8) | (this->beacon_data_.major >> 8); }
   uint16_t get_minor() { return ((this->beacon_data_.minor & 0xFF) << 8) | (this->beacon_data_.minor >> 8); }
@@ -54,6 +121,13 @@ class ESPBLEiBeacon {
   } PACKED beacon_data_;
 };
 
+/** A scan result of the tracker.
+ *
+ * The advertisement data is only copied into the vectors returned by get_service_uuids(), get_service_datas() etc.
+ * when one of them is first used. The allocation free accessors get_adv_records(), has_service_uuid(),
+ * find_service_data() and find_manufacturer_data() walk the raw advertisement data instead, the data they return
+ * points into this device.
+ */
 class ESPBTDevice {
  public:
   void parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
@@ -66,23 +140,58 @@ class ESPBTDevice {
 
   esp_ble_addr_type_t get_address_type() const { return this->address_type_; }
   int get_rssi() const { return rssi_; }
-  const std::string &get_name() const { return this->name_; }
+  const std::string &get_name() const {
+    this->parse_adv_();
+    return this->name_;
+  }
 
-  const std::vector<int8_t> &get_tx_powers() const { return tx_powers_; }
+  const std::vector<int8_t> &get_tx_powers() const {
+    this->parse_adv_();
+    return tx_powers_;
+  }
 
-  const optional<uint16_t> &get_appearance() const { return appearance_; }
-  const optional<uint8_t> &get_ad_flag() const { return ad_flag_; }
-  const std::vector<ESPBTUUID> &get_service_uuids() const { return service_uuids_; }
+  const optional<uint16_t> &get_appearance() const {
+    this->parse_adv_();
+    return appearance_;
+  }
+  const optional<uint8_t> &get_ad_flag() const {
+    this->parse_adv_();
+    return ad_flag_;
+  }
+  const std::vector<ESPBTUUID> &get_service_uuids() const {
+    this->parse_adv_();
+    return service_uuids_;
+  }
 
-  const std::vector<ServiceData> &get_manufacturer_datas() const { return manufacturer_datas_; }
+  const std::vector<ServiceData> &get_manufacturer_datas() const {
+    this->parse_adv_();
+    return manufacturer_datas_;
+  }
+
+  const std::vector<ServiceData> &get_service_datas() const {
+    this->parse_adv_();
+    return service_datas_;
+  }
 
-  const std::vector<ServiceData> &get_service_datas() const { return service_datas_; }
+  AdvRecords get_adv_records() const {
+    return {this->scan_result_.ble_adv,
+            static_cast<uint8_t>(this->scan_result_.adv_data_len + this->scan_result_.scan_rsp_len)};
+  }
+  /// Whether uuid is in one of the service UUID lists of the advertisement.
+  bool has_service_uuid(const ESPBTUUID &uuid) const;
+  /// The first service data for uuid.
+  optional<ServiceDataView> find_service_data(const ESPBTUUID &uuid) const;
+  /// The first manufacturer data with this company identifier.
+  optional<ServiceDataView> find_manufacturer_data(const ESPBTUUID &company) const;
 
   const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &get_scan_result() const { return scan_result_; }
 
   optional<ESPBLEiBeacon> get_ibeacon() const {
-    for (auto &it : this->manufacturer_datas_) {
-      auto res = ESPBLEiBeacon::from_manufacturer_data(it);
+    for (const auto &record : this->get_adv_records()) {
+      auto data = record.get_manufacturer_data();
+      if (!data.has_value())
+        continue;
+      auto res = ESPBLEiBeacon::from_manufacturer_data(*data);
       if (res.has_value())
         return *res;
     }
@@ -90,20 +199,22 @@ class ESPBTDevice {
   }
 
  protected:
-  void parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
+  /// Copy the advertisement data into the members, if that hasn't happened yet.
+  void parse_adv_() const;
 
   esp_bd_addr_t address_{
       0,
   };
   esp_ble_addr_type_t address_type_{BLE_ADDR_TYPE_PUBLIC};
   int rssi_{0};
-  std::string name_{};
-  std::vector<int8_t> tx_powers_{};
-  optional<uint16_t> appearance_{};
-  optional<uint8_t> ad_flag_{};
-  std::vector<ESPBTUUID> service_uuids_{};
-  std::vector<ServiceData> manufacturer_datas_{};
-  std::vector<ServiceData> service_datas_{};
+  mutable bool adv_parsed_{false};
+  mutable std::string name_{};
+  mutable std::vector<int8_t> tx_powers_{};
+  mutable optional<uint16_t> appearance_{};
+  mutable optional<uint8_t> ad_flag_{};
+  mutable std::vector<ESPBTUUID> service_uuids_{};
+  mutable std::vector<ServiceData> manufacturer_datas_{};
+  mutable std::vector<ServiceData> service_datas_{};
   esp_ble_gap_cb_param_t::ble_scan_result_evt_param scan_result_{};
 };
 
@@ -113,6 +224,16 @@ class ESPBTDeviceListener {
  public:
   virtual void on_scan_end() {}
   virtual bool parse_device(const ESPBTDevice &device) = 0;
+  /** The addresses of the devices parse_device() is interested in, empty for all.
+   *
+   * Asked once before the first scan results are dispatched. Advertisements that no listener asked for aren't parsed
+   * into an ESPBTDevice at all.
+   */
+  virtual std::vector<uint64_t> get_address_filter() const { return {}; }
+  /** If there is no address filter, parse_device() is only called for advertisements that list one of these service
+   * UUIDs or carry service data for it. Empty for all advertisements.
+   */
+  virtual std::vector<ESPBTUUID> get_service_uuid_filter() const { return {}; }
   virtual bool parse_devices(esp_ble_gap_cb_param_t::ble_scan_result_evt_param *advertisements, size_t count) {
     return false;
   };
@@ -161,12 +282,21 @@ class ESPBTClient : public ESPBTDeviceListener {
                                    esp_ble_gattc_cb_param_t *param) = 0;
   virtual void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) = 0;
   virtual void connect() = 0;
-  virtual void set_state(ClientState st) { this->state_ = st; }
+  /// Whether parse_device() may accept the device with this address, asked for every advertisement.
+  virtual bool accepts_address(uint64_t address) const { return true; }
+  virtual void set_state(ClientState st) {
+    if (st == ClientState::DISCOVERED && this->state_ != ClientState::DISCOVERED)
+      this->discovered_at_ = millis();
+    this->state_ = st;
+  }
   ClientState state() const { return state_; }
+  /// When the device of the client was discovered, the longest waiting client is connected first.
+  uint32_t get_discovered_at() const { return this->discovered_at_; }
   int app_id;
 
  protected:
   ClientState state_;
+  uint32_t discovered_at_{0};
 };
 
 class ESP32BLETracker : public Component, public GAPEventHandler, public GATTcEventHandler, public Parented<ESP32BLE> {
@@ -187,10 +317,16 @@ class ESP32BLETracker : public Component, public GAPEventHandler, public GATTcEv
   void register_listener(ESPBTDeviceListener *listener) {
     listener->set_parent(this);
     this->listeners_.push_back(listener);
+    this->listener_index_valid_ = false;
   }
 
   void register_client(ESPBTClient *client);
 
+#ifdef USE_SENSOR
+  /// Publish the number of advertisements dropped in the last minute because the loop didn't keep up.
+  void set_dropped_advertisements_sensor(sensor::Sensor *sensor) { this->dropped_advertisements_sensor_ = sensor; }
+#endif
+
   void print_bt_device_info(const ESPBTDevice &device);
 
   void start_scan();
@@ -213,12 +349,27 @@ class ESP32BLETracker : public Component, public GAPEventHandler, public GATTcEv
   void gap_scan_start_complete_(const esp_ble_gap_cb_param_t::ble_scan_start_cmpl_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_STOP_COMPLETE_EVT` event is received.
   void gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_scan_stop_cmpl_evt_param &param);
+  /// Sort the listeners by the advertisements they are interested in.
+  void index_listeners_();
+  /// Pass a scan result to the listeners and clients interested in it, returns true if one of the clients was
+  /// discovered.
+  bool dispatch_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &result, bool connecting);
 
   int app_id_;
 
-  /// Vector of addresses that have already been printed in print_bt_device_info
-  std::vector<uint64_t> already_discovered_;
+  /// Addresses that have already been printed in print_bt_device_info. Up to 8192 slots (64 KiB) in external RAM,
+  /// 1024 slots (8 KiB, 12 KiB while growing) without it.
+  AddressSet already_discovered_{8192};
   std::vector<ESPBTDeviceListener *> listeners_;
+  /// Listeners by the addresses in their filter.
+  std::unordered_map<uint64_t, std::vector<ESPBTDeviceListener *>> address_listeners_;
+  /// Listeners with a service UUID filter, and the UUIDs of the filter.
+  std::vector<std::pair<ESPBTUUID, ESPBTDeviceListener *>> service_uuid_listeners_;
+  /// Listeners without any filter.
+  std::vector<ESPBTDeviceListener *> unfiltered_listeners_;
+  /// The listeners interested in the scan result being dispatched.
+  std::vector<ESPBTDeviceListener *> interested_listeners_;
+  bool listener_index_valid_{false};
   /// Client parameters.
   std::vector<ESPBTClient *> clients_;
   /// A structure holding the ESP BLE scan parameters.
@@ -231,15 +382,26 @@ class ESP32BLETracker : public Component, public GAPEventHandler, public GATTcEv
   bool scan_continuous_;
   bool scan_active_;
   bool scanner_idle_;
+  /// Only held to add a result or to swap the buffers, never while results are processed.
   SemaphoreHandle_t scan_result_lock_;
   SemaphoreHandle_t scan_end_lock_;
   size_t scan_result_index_{0};
+  /// Scan results that didn't fit into the buffer since the last swap.
+  uint32_t scan_result_dropped_{0};
+  /// Scan results dropped since the sensor was last published.
+  uint32_t dropped_advertisements_{0};
+#ifdef USE_SENSOR
+  sensor::Sensor *dropped_advertisements_sensor_{nullptr};
+#endif
 #if CONFIG_SPIRAM
   const static u_int8_t SCAN_RESULT_BUFFER_SIZE = 32;
 #else
   const static u_int8_t SCAN_RESULT_BUFFER_SIZE = 16;
 #endif  // CONFIG_SPIRAM
+  /// The buffer the GAP callback adds scan results to.
   esp_ble_gap_cb_param_t::ble_scan_result_evt_param *scan_result_buffer_;
+  /// The buffer the loop processes while the other one is filled.
+  esp_ble_gap_cb_param_t::ble_scan_result_evt_param *scan_result_ready_buffer_;
   esp_bt_status_t scan_start_failed_{ESP_BT_STATUS_SUCCESS};
   esp_bt_status_t scan_set_param_failed_{ESP_BT_STATUS_SUCCESS};
 };
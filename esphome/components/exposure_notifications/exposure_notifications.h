@@ -20,6 +20,9 @@ struct ExposureNotification {
 class ExposureNotificationTrigger : public Trigger<ExposureNotification>,
                                     public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  std::vector<esp32_ble_tracker::ESPBTUUID> get_service_uuid_filter() const override {
+    return {esp32_ble_tracker::ESPBTUUID::from_uint16(0xFD6F)};
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
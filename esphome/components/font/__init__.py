@@ -3,6 +3,7 @@ from pathlib import Path
 import hashlib
 import os
 import re
+import struct
 
 import requests
 
@@ -32,6 +33,7 @@ MULTI_CONF = True
 Font = display.display_ns.class_("Font")
 Glyph = display.display_ns.class_("Glyph")
 GlyphData = display.display_ns.struct("GlyphData")
+KerningData = display.display_ns.struct("KerningData")
 
 
 def validate_glyphs(value):
@@ -238,6 +240,9 @@ DEFAULT_GLYPHS = (
     ' !"%()+=,-.:/0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz°'
 )
 CONF_RAW_GLYPH_ID = "raw_glyph_id"
+CONF_RAW_KERNING_ID = "raw_kerning_id"
+CONF_BPP = "bpp"
+CONF_KERNING = "kerning"
 
 FONT_SCHEMA = cv.Schema(
     {
@@ -245,12 +250,28 @@ FONT_SCHEMA = cv.Schema(
         cv.Required(CONF_FILE): FILE_SCHEMA,
         cv.Optional(CONF_GLYPHS, default=DEFAULT_GLYPHS): validate_glyphs,
         cv.Optional(CONF_SIZE, default=20): cv.int_range(min=1),
+        cv.Optional(CONF_BPP, default=1): cv.one_of(1, 2, 4, int=True),
+        cv.Optional(CONF_KERNING, default=False): cv.boolean,
         cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         cv.GenerateID(CONF_RAW_GLYPH_ID): cv.declare_id(GlyphData),
+        cv.GenerateID(CONF_RAW_KERNING_ID): cv.declare_id(KerningData),
     }
 )
 
-CONFIG_SCHEMA = cv.All(validate_pillow_installed, FONT_SCHEMA)
+
+def validate_kerning(config):
+    if config[CONF_KERNING]:
+        from PIL import ImageFont
+
+        if not hasattr(ImageFont.FreeTypeFont, "getlength"):
+            raise cv.Invalid(
+                "Kerning requires pillow 8.0.0 or newer. (pip install -U pillow)",
+                path=[CONF_KERNING],
+            )
+    return config
+
+
+CONFIG_SCHEMA = cv.All(validate_pillow_installed, FONT_SCHEMA, validate_kerning)
 
 # PIL doesn't provide a consistent interface for both TrueType and bitmap
 # fonts. So, we use our own wrappers to give us the consistency that we need.
@@ -259,6 +280,7 @@ CONFIG_SCHEMA = cv.All(validate_pillow_installed, FONT_SCHEMA)
 class TrueTypeFontWrapper:
     def __init__(self, font):
         self.font = font
+        self.lengths = {}
 
     def getoffset(self, glyph):
         _, (offset_x, offset_y) = self.font.font.getsize(glyph)
@@ -270,6 +292,30 @@ class TrueTypeFontWrapper:
     def getmetrics(self, glyphs):
         return self.font.getmetrics()
 
+    def getlength(self, glyph):
+        if glyph not in self.lengths:
+            self.lengths[glyph] = self.font.getlength(glyph)
+        return self.lengths[glyph]
+
+    def haskerning(self):
+        # Only a kern or GPOS table can adjust the advance of a pair, fonts
+        # without them don't need every pair measured.
+        try:
+            with open(self.font.path, "rb") as f:
+                header = f.read(12)
+                if header[:4] == b"ttcf":
+                    return True
+                (num_tables,) = struct.unpack(">H", header[4:6])
+                records = f.read(16 * num_tables)
+        except (OSError, TypeError, struct.error):
+            return True
+        tags = {records[i : i + 4] for i in range(0, len(records), 16)}
+        return bool(tags & {b"kern", b"GPOS"})
+
+    def getkerning(self, first, second):
+        pair = self.font.getlength(first + second)
+        return round(pair - self.getlength(first) - self.getlength(second))
+
 
 class BitmapFontWrapper:
     def __init__(self, font):
@@ -291,6 +337,12 @@ class BitmapFontWrapper:
                 max_height = height
         return (max_height, 0)
 
+    def haskerning(self):
+        return False
+
+    def getkerning(self, first, second):
+        return 0
+
 
 def convert_bitmap_to_pillow_font(filepath):
     from PIL import PcfFontFile, BdfFontFile
@@ -362,20 +414,25 @@ async def to_code(config):
 
     ascent, descent = font.getmetrics(config[CONF_GLYPHS])
 
+    bpp = config[CONF_BPP]
+    max_value = (1 << bpp) - 1
     glyph_args = {}
     data = []
     for glyph in config[CONF_GLYPHS]:
-        mask = font.getmask(glyph, mode="1")
+        mask = font.getmask(glyph, mode="1" if bpp == 1 else "L")
         offset_x, offset_y = font.getoffset(glyph)
         width, height = mask.size
-        width8 = ((width + 7) // 8) * 8
-        glyph_data = [0] * (height * width8 // 8)
+        # every row starts on a byte boundary, pixels are packed MSB first
+        stride = (width * bpp + 7) // 8
+        glyph_data = [0] * (height * stride)
         for y in range(height):
             for x in range(width):
-                if not mask.getpixel((x, y)):
+                pixel = mask.getpixel((x, y))
+                if not pixel:
                     continue
-                pos = x + y * width8
-                glyph_data[pos // 8] |= 0x80 >> (pos % 8)
+                value = 1 if bpp == 1 else (pixel * max_value + 127) // 255
+                pos = x * bpp
+                glyph_data[y * stride + pos // 8] |= value << (8 - bpp - pos % 8)
         glyph_args[glyph] = (len(data), offset_x, offset_y, width, height)
         data += glyph_data
 
@@ -401,6 +458,26 @@ async def to_code(config):
 
     glyphs = cg.static_const_array(config[CONF_RAW_GLYPH_ID], glyph_initializer)
 
-    cg.new_Pvariable(
-        config[CONF_ID], glyphs, len(glyph_initializer), ascent, ascent + descent
+    var = cg.new_Pvariable(
+        config[CONF_ID], glyphs, len(glyph_initializer), ascent, ascent + descent, bpp
     )
+
+    if config[CONF_KERNING] and font.haskerning():
+        kerning_initializer = []
+        for first_index, first in enumerate(config[CONF_GLYPHS]):
+            for second_index, second in enumerate(config[CONF_GLYPHS]):
+                offset = font.getkerning(first, second)
+                if offset:
+                    kerning_initializer.append(
+                        cg.StructInitializer(
+                            KerningData,
+                            ("first", first_index),
+                            ("second", second_index),
+                            ("offset", offset),
+                        )
+                    )
+        if kerning_initializer:
+            kerning = cg.static_const_array(
+                config[CONF_RAW_KERNING_ID], kerning_initializer
+            )
+            cg.add(var.set_kerning(kerning, len(kerning_initializer)))
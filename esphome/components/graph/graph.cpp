@@ -18,9 +18,32 @@ static const char *const TAGL = "graphlegend";
 void HistoryData::init(int length) {
   this->length_ = length;
   this->samples_.resize(length, NAN);
+  this->max_queue_.init(length);
+  this->min_queue_.init(length);
   this->last_sample_ = millis();
 }
 
+void HistoryData::push_sample_(float data) {
+  const uint32_t seq = this->written_++;
+  this->samples_[this->count_] = data;
+  this->count_ = (this->count_ + 1) % this->length_;
+
+  // drop the samples that were just overwritten in the ring
+  while (!this->max_queue_.empty() && seq - this->max_queue_.front() >= (uint32_t) this->length_)
+    this->max_queue_.pop_front();
+  while (!this->min_queue_.empty() && seq - this->min_queue_.front() >= (uint32_t) this->length_)
+    this->min_queue_.pop_front();
+  if (std::isnan(data))
+    return;
+  // older samples that are not larger (smaller) than the new one can never be the maximum (minimum) again
+  while (!this->max_queue_.empty() && this->get_sample_(this->max_queue_.back()) <= data)
+    this->max_queue_.pop_back();
+  this->max_queue_.push_back(seq);
+  while (!this->min_queue_.empty() && this->get_sample_(this->min_queue_.back()) >= data)
+    this->min_queue_.pop_back();
+  this->min_queue_.push_back(seq);
+}
+
 void HistoryData::take_sample(float data) {
   uint32_t tm = millis();
   uint32_t dt = tm - last_sample_;
@@ -29,23 +52,18 @@ void HistoryData::take_sample(float data) {
   // Step data based on time
   this->period_ += dt;
   while (this->period_ >= this->update_time_) {
-    this->samples_[this->count_] = data;
+    this->push_sample_(data);
     this->period_ -= this->update_time_;
-    this->count_ = (this->count_ + 1) % this->length_;
     ESP_LOGV(TAG, "Updating trace with value: %f", data);
   }
   if (!std::isnan(data)) {
-    // Recalc recent max/min
+    // Recent max/min over the ring and the current value
     this->recent_min_ = data;
     this->recent_max_ = data;
-    for (int i = 0; i < this->length_; i++) {
-      if (!std::isnan(this->samples_[i])) {
-        if (this->recent_max_ < this->samples_[i])
-          this->recent_max_ = this->samples_[i];
-        if (this->recent_min_ > this->samples_[i])
-          this->recent_min_ = this->samples_[i];
-      }
-    }
+    if (!this->max_queue_.empty())
+      this->recent_max_ = std::max(this->recent_max_, this->get_sample_(this->max_queue_.front()));
+    if (!this->min_queue_.empty())
+      this->recent_min_ = std::min(this->recent_min_, this->get_sample_(this->min_queue_.front()));
   }
 }
 
@@ -83,6 +83,29 @@ class GraphLegend {
   friend Graph;
 };
 
+/// Fixed capacity ring of sample sequence numbers, used as monotonic queue to track the extremes of a sliding window.
+class SampleQueue {
+ public:
+  void init(int capacity) { this->seqs_.resize(capacity); }
+  bool empty() const { return this->size_ == 0; }
+  uint32_t front() const { return this->seqs_[this->head_]; }
+  uint32_t back() const { return this->seqs_[(this->head_ + this->size_ - 1) % this->seqs_.size()]; }
+  void pop_front() {
+    this->head_ = (this->head_ + 1) % this->seqs_.size();
+    this->size_--;
+  }
+  void pop_back() { this->size_--; }
+  void push_back(uint32_t seq) {
+    this->seqs_[(this->head_ + this->size_) % this->seqs_.size()] = seq;
+    this->size_++;
+  }
+
+ protected:
+  std::vector<uint32_t> seqs_;
+  size_t head_{0};
+  size_t size_{0};
+};
+
 class HistoryData {
  public:
   void init(int length);
@@ -95,6 +118,9 @@ class HistoryData {
   float get_recent_min() const { return recent_min_; }
 
  protected:
+  void push_sample_(float data);
+  float get_sample_(uint32_t seq) const { return samples_[seq % length_]; }
+
   uint32_t last_sample_;
   uint32_t period_{0};       /// in ms
   uint32_t update_time_{0};  /// in ms
@@ -103,6 +129,11 @@ class HistoryData {
   float recent_min_{NAN};
   float recent_max_{NAN};
   std::vector<float> samples_;
+  uint32_t written_{0};  /// number of samples written so far, the sequence number of the next sample
+  // sequence numbers of the samples in the ring that can still become the maximum (decreasing values) or
+  // the minimum (increasing values), so both can be updated in amortized O(1) per sample
+  SampleQueue max_queue_;
+  SampleQueue min_queue_;
 };
 
 class GraphTrace {
@@ -1,5 +1,4 @@
 #include "ili9xxx_display.h"
-#include "esphome/core/application.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
@@ -27,6 +26,11 @@ void ILI9XXXDisplay::setup() {
   this->init_internal_(this->get_buffer_length_());
   if (this->buffer_ == nullptr) {
     this->mark_failed();
+    return;
+  }
+  if (this->buffer_color_mode_ == BITS_8_INDEXED) {
+    this->palette_lut_ = new uint16_t[256];  // NOLINT(cppcoreguidelines-owning-memory)
+    display::ColorUtil::palette888_to_565_lut(this->palette_, this->palette_lut_);
   }
 }
 
@@ -147,6 +151,72 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
   }
 }
 
+void HOT ILI9XXXDisplay::blend_absolute_row_internal(int x, int y, const uint8_t *alpha, int width, Color color) {
+  if (this->buffer_color_mode_ != BITS_16) {
+    // 8 bit buffers are too coarse to blend into
+    DisplayBuffer::blend_absolute_row_internal(x, y, alpha, width, color);
+    return;
+  }
+  const uint16_t fg = display::ColorUtil::color_to_565(color, display::ColorOrder::COLOR_ORDER_RGB);
+  uint8_t *pos = this->buffer_ + ((y * this->width_) + x) * 2;
+  int first = width, last = -1;
+  for (int i = 0; i < width; i++, pos += 2) {
+    if (alpha[i] == 0)
+      continue;
+    const uint16_t bg = (uint16_t) pos[0] << 8 | pos[1];
+    const uint16_t new_color = alpha[i] == 0xFF ? fg : display::ColorUtil::blend_565(fg, bg, alpha[i]);
+    if (new_color == bg)
+      continue;
+    pos[0] = new_color >> 8;
+    pos[1] = new_color;
+    first = std::min(first, i);
+    last = i;
+  }
+  if (last < 0)
+    return;
+  // low and high watermark may speed up drawing from buffer
+  this->x_low_ = std::min<uint16_t>(this->x_low_, x + first);
+  this->y_low_ = std::min<uint16_t>(this->y_low_, y);
+  this->x_high_ = std::max<uint16_t>(this->x_high_, x + last);
+  this->y_high_ = std::max<uint16_t>(this->y_high_, y);
+}
+
+void HOT ILI9XXXDisplay::fill_absolute_row_internal(int x, int y, int width, Color color) {
+  int first = width, last = -1;
+  if (this->buffer_color_mode_ == BITS_16) {
+    const uint16_t new_color = display::ColorUtil::color_to_565(color, display::ColorOrder::COLOR_ORDER_RGB);
+    const uint8_t high = new_color >> 8, low = new_color;
+    uint8_t *pos = this->buffer_ + ((y * this->width_) + x) * 2;
+    for (int i = 0; i < width; i++, pos += 2) {
+      if (pos[0] == high && pos[1] == low)
+        continue;
+      pos[0] = high;
+      pos[1] = low;
+      first = std::min(first, i);
+      last = i;
+    }
+  } else {
+    const uint8_t new_color = this->buffer_color_mode_ == BITS_8_INDEXED
+                                  ? display::ColorUtil::color_to_index8_palette888(color, this->palette_)
+                                  : display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
+    uint8_t *pos = this->buffer_ + (y * this->width_) + x;
+    for (int i = 0; i < width; i++, pos++) {
+      if (*pos == new_color)
+        continue;
+      *pos = new_color;
+      first = std::min(first, i);
+      last = i;
+    }
+  }
+  if (last < 0)
+    return;
+  // low and high watermark may speed up drawing from buffer
+  this->x_low_ = std::min<uint16_t>(this->x_low_, x + first);
+  this->y_low_ = std::min<uint16_t>(this->y_low_, y);
+  this->x_high_ = std::max<uint16_t>(this->x_high_, x + last);
+  this->y_high_ = std::max<uint16_t>(this->y_high_, y);
+}
+
 void ILI9XXXDisplay::update() {
   if (this->prossing_update_) {
     this->need_update_ = true;
@@ -163,85 +233,112 @@ void ILI9XXXDisplay::update() {
   this->display_();
 }
 
-void ILI9XXXDisplay::display_() {
-  // we will only update the changed window to the display
-  uint16_t w = this->x_high_ - this->x_low_ + 1;  // NOLINT
-  uint16_t h = this->y_high_ - this->y_low_ + 1;  // NOLINT
-  uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
+void ILI9XXXDisplay::loop() {
+  if (this->flushing_) {
+    this->flush_();
+  } else if (this->flush_requested_) {
+    this->display_();
+  }
+}
 
+void ILI9XXXDisplay::display_() {
   // check if something was displayed
   if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
     ESP_LOGV(TAG, "Nothing to display");
+    this->flush_requested_ = false;
     return;
   }
 
-  set_addr_window_(this->x_low_, this->y_low_, w, h);
+  if (this->flushing_) {
+    // the watermarks keep growing while the previous window is sent, pick them up once it is done
+    this->flush_requested_ = true;
+    return;
+  }
+  this->flush_requested_ = false;
 
-  ESP_LOGV(TAG,
-           "Start display(xlow:%d, ylow:%d, xhigh:%d, yhigh:%d, width:%d, "
-           "heigth:%d, start_pos:%d)",
-           this->x_low_, this->y_low_, this->x_high_, this->y_high_, w, h, start_pos);
+  // we will only update the changed window to the display
+  this->flush_x_ = this->x_low_;
+  this->flush_y_ = this->y_low_;
+  this->flush_w_ = this->x_high_ - this->x_low_ + 1;  // NOLINT
+  this->flush_h_ = this->y_high_ - this->y_low_ + 1;  // NOLINT
+  this->flush_row_ = 0;
 
-  this->start_data_();
-  for (uint16_t row = 0; row < h; row++) {
-    uint32_t pos = start_pos + (row * width_);
-    uint32_t rem = w;
+  ESP_LOGV(TAG, "Start display(xlow:%d, ylow:%d, xhigh:%d, yhigh:%d, width:%d, heigth:%d)", this->x_low_, this->y_low_,
+           this->x_high_, this->y_high_, this->flush_w_, this->flush_h_);
 
-    while (rem > 0) {
-      uint32_t sz = std::min(rem, ILI9XXX_TRANSFER_BUFFER_SIZE);
-      // ESP_LOGVV(TAG, "Send to display(pos:%d, rem:%d, zs:%d)", pos, rem, sz);
-      buffer_to_transfer_(pos, sz);
-      if (this->is_18bitdisplay_) {
-        for (uint32_t i = 0; i < sz; ++i) {
-          uint16_t color_val = transfer_buffer_[i];
+  // invalidate watermarks, pixels drawn from now on are part of the next flush
+  this->x_low_ = this->width_;
+  this->y_low_ = this->height_;
+  this->x_high_ = 0;
+  this->y_high_ = 0;
 
-          uint8_t red = color_val & 0x1F;
-          uint8_t green = (color_val & 0x7E0) >> 5;
-          uint8_t blue = (color_val & 0xF800) >> 11;
+  this->flushing_ = true;
+  this->high_freq_.start();
+  this->flush_();
+}
 
-          uint8_t pass_buff[3];
+void ILI9XXXDisplay::flush_() {
+  const uint32_t start = millis();
+  const bool direct = this->buffer_color_mode_ == BITS_16 && !this->is_18bitdisplay_;
 
-          pass_buff[2] = (uint8_t) ((red / 32.0) * 64) << 2;
-          pass_buff[1] = (uint8_t) green << 2;
-          pass_buff[0] = (uint8_t) ((blue / 32.0) * 64) << 2;
+  // the address window is re-sent for every slice, so other devices can use the bus in between
+  set_addr_window_(this->flush_x_, this->flush_y_ + this->flush_row_, this->flush_w_,
+                   this->flush_h_ - this->flush_row_);
 
-          this->write_array(pass_buff, sizeof(pass_buff));
-        }
-      } else {
-        this->write_array16(transfer_buffer_, sz);
+  this->start_data_();
+  while (this->flush_row_ < this->flush_h_) {
+    uint32_t pos = ((this->flush_y_ + this->flush_row_) * this->width_) + this->flush_x_;
+    this->flush_row_++;
+
+    if (direct) {
+      // the buffer already holds big-endian 565 pixels, send the whole row at once
+      this->write_array(this->buffer_ + pos * 2, this->flush_w_ * 2);
+    } else {
+      uint32_t rem = this->flush_w_;
+      while (rem > 0) {
+        uint32_t sz = std::min(rem, ILI9XXX_TRANSFER_BUFFER_SIZE);
+        // ESP_LOGVV(TAG, "Send to display(pos:%d, rem:%d, zs:%d)", pos, rem, sz);
+        this->write_array(this->transfer_buffer_, this->buffer_to_transfer_(pos, sz));
+        pos += sz;
+        rem -= sz;
       }
-      pos += sz;
-      rem -= sz;
     }
-    App.feed_wdt();
+
+    if (millis() - start >= ILI9XXX_FLUSH_BUDGET_MS)
+      break;
   }
   this->end_data_();
 
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
+  if (this->flush_row_ < this->flush_h_) {
+    // continue in the next loop() iteration
+    return;
+  }
+
+  this->flushing_ = false;
+  this->high_freq_.stop();
 }
 
 uint32_t ILI9XXXDisplay::buffer_to_transfer_(uint32_t pos, uint32_t sz) {
-  for (uint32_t i = 0; i < sz; ++i) {
-    switch (this->buffer_color_mode_) {
-      case BITS_8_INDEXED:
-        transfer_buffer_[i] = display::ColorUtil::color_to_565(
-            display::ColorUtil::index8_to_color_palette888(this->buffer_[pos + i], this->palette_));
-        break;
-      case BITS_16:
-        transfer_buffer_[i] = ((uint16_t) this->buffer_[(pos + i) * 2] << 8) | this->buffer_[((pos + i) * 2) + 1];
-        continue;
-        break;
-      default:
-        transfer_buffer_[i] =
-            display::ColorUtil::color_to_565(display::ColorUtil::rgb332_to_color(this->buffer_[pos + i]));
-        break;
-    }
+  // for 18-bit displays the 565 pixels are staged behind the 666 output, which is then converted in place
+  uint8_t *rgb565 = this->is_18bitdisplay_ ? this->transfer_buffer_ + sz : this->transfer_buffer_;
+  const uint8_t *src = rgb565;
+  switch (this->buffer_color_mode_) {
+    case BITS_8_INDEXED:
+      display::ColorUtil::index8_to_565_be(this->buffer_ + pos, rgb565, sz, this->palette_lut_);
+      break;
+    case BITS_16:
+      src = this->buffer_ + pos * 2;
+      if (!this->is_18bitdisplay_)
+        memcpy(this->transfer_buffer_, src, sz * 2);
+      break;
+    default:
+      display::ColorUtil::rgb332_to_565_be(this->buffer_ + pos, rgb565, sz);
+      break;
   }
-  return sz;
+  if (!this->is_18bitdisplay_)
+    return sz * 2;
+  display::ColorUtil::rgb565_be_to_666(src, this->transfer_buffer_, sz);
+  return sz * 3;
 }
 
 // should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
@@ -8,6 +8,8 @@ namespace esphome {
 namespace ili9xxx {
 
 const uint32_t ILI9XXX_TRANSFER_BUFFER_SIZE = 64;
+/// Maximum time a single loop() iteration may spend pushing the framebuffer to the display.
+const uint32_t ILI9XXX_FLUSH_BUDGET_MS = 8;
 
 enum ILI9XXXColorMode {
   BITS_8 = 0x08,
@@ -35,6 +37,7 @@ class ILI9XXXDisplay : public PollingComponent,
   uint8_t read_command(uint8_t command_byte, uint8_t index);
 
   void update() override;
+  void loop() override;
 
   void fill(Color color) override;
 
@@ -45,10 +48,13 @@ class ILI9XXXDisplay : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void blend_absolute_row_internal(int x, int y, const uint8_t *alpha, int width, Color color) override;
+  void fill_absolute_row_internal(int x, int y, int width, Color color) override;
   void setup_pins_();
   virtual void initialize() = 0;
 
   void display_();
+  void flush_();
   void init_lcd_(const uint8_t *init_cmd);
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
   void invert_display_(bool invert);
@@ -73,7 +79,9 @@ class ILI9XXXDisplay : public PollingComponent,
   void start_data_();
   void end_data_();
 
-  uint16_t transfer_buffer_[ILI9XXX_TRANSFER_BUFFER_SIZE];
+  // big enough for a chunk of 18-bit pixels (3 bytes each)
+  uint8_t transfer_buffer_[ILI9XXX_TRANSFER_BUFFER_SIZE * 3];
+  uint16_t *palette_lut_{nullptr};  ///< RGB565 value of every palette entry in BITS_8_INDEXED mode
 
   uint32_t buffer_to_transfer_(uint32_t pos, uint32_t sz);
 
@@ -81,6 +89,16 @@ class ILI9XXXDisplay : public PollingComponent,
   GPIOPin *dc_pin_{nullptr};
   GPIOPin *busy_pin_{nullptr};
 
+  // window currently being flushed; drawing may continue into x_low_/y_low_/x_high_/y_high_ meanwhile
+  uint16_t flush_x_{0};
+  uint16_t flush_y_{0};
+  uint16_t flush_w_{0};
+  uint16_t flush_h_{0};
+  uint16_t flush_row_{0};
+  bool flushing_{false};
+  bool flush_requested_{false};
+  HighFrequencyLoopRequester high_freq_;
+
   bool prossing_update_ = false;
   bool need_update_ = false;
   bool is_18bitdisplay_ = false;
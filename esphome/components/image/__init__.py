@@ -39,6 +39,21 @@ IMAGE_TYPE = {
 }
 
 CONF_USE_TRANSPARENCY = "use_transparency"
+CONF_COMPRESSION = "compression"
+
+ImageCompression = display.display_ns.enum("ImageCompression")
+IMAGE_COMPRESSION = {
+    "NONE": ImageCompression.IMAGE_COMPRESSION_NONE,
+    "RLE": ImageCompression.IMAGE_COMPRESSION_RLE,
+}
+
+# Size of a single pixel for the image types that can be compressed.
+BYTES_PER_PIXEL = {
+    "GRAYSCALE": 1,
+    "RGB565": 2,
+    "RGB24": 3,
+    "RGBA": 4,
+}
 
 # If the MDI file cannot be downloaded within this time, abort.
 MDI_DOWNLOAD_TIMEOUT = 30  # seconds
@@ -119,9 +134,62 @@ def validate_cross_dependencies(config):
     if is_mdi and config[CONF_TYPE] not in ["BINARY", "TRANSPARENT_BINARY"]:
         raise cv.Invalid("MDI images must be binary images.")
 
+    validate_compression(config)
+
     return config
 
 
+def validate_compression(config):
+    if config[CONF_COMPRESSION] != "NONE" and config[CONF_TYPE] not in BYTES_PER_PIXEL:
+        raise cv.Invalid(
+            f"Compression is not supported for {config[CONF_TYPE]} images.",
+            path=[CONF_COMPRESSION],
+        )
+
+
+def rle_encode(data, width, height, frames, bytes_per_pixel):
+    """Run-length encode raw pixel data row by row.
+
+    The result starts with a table of big-endian 32 bit offsets (relative to the start
+    of the data), one per row of every frame, followed by the packets. A packet header
+    with the top bit set is followed by a single pixel repeated (header & 0x7F) + 1 times,
+    otherwise (header + 1) literal pixels follow. Packets never cross rows, so every row
+    can be decoded on its own.
+    """
+    rows = height * frames
+    offsets = []
+    packets = []
+    for row in range(rows):
+        offsets += list((rows * 4 + len(packets)).to_bytes(4, "big"))
+        base = row * width * bytes_per_pixel
+        pixels = [
+            data[base + x * bytes_per_pixel : base + (x + 1) * bytes_per_pixel]
+            for x in range(width)
+        ]
+        x = 0
+        while x < width:
+            run = 1
+            while x + run < width and run < 128 and pixels[x + run] == pixels[x]:
+                run += 1
+            if run > 1:
+                packets.append(0x80 | (run - 1))
+                packets += pixels[x]
+                x += run
+                continue
+            end = x + 1
+            while (
+                end < width
+                and end - x < 128
+                and not (end + 1 < width and pixels[end] == pixels[end + 1])
+            ):
+                end += 1
+            packets.append(end - x - 1)
+            for pixel in pixels[x:end]:
+                packets += pixel
+            x = end
+    return offsets + packets
+
+
 def validate_file_shorthand(value):
     value = cv.string_strict(value)
     if value.startswith("mdi:"):
@@ -190,6 +258,9 @@ IMAGE_SCHEMA = cv.Schema(
             cv.Optional(CONF_DITHER, default="NONE"): cv.one_of(
                 "NONE", "FLOYDSTEINBERG", upper=True
             ),
+            cv.Optional(CONF_COMPRESSION, default="NONE"): cv.enum(
+                IMAGE_COMPRESSION, upper=True
+            ),
             cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         },
         validate_cross_dependencies,
@@ -339,9 +410,19 @@ async def to_code(config):
             f"Image f{config[CONF_ID]} has an unsupported type: {config[CONF_TYPE]}."
         )
 
+    compression = config[CONF_COMPRESSION]
+    if compression == "RLE":
+        raw_size = len(data)
+        data = rle_encode(data, width, height, 1, BYTES_PER_PIXEL[config[CONF_TYPE]])
+        _LOGGER.debug(
+            "%s compressed from %d to %d bytes", config[CONF_ID], raw_size, len(data)
+        )
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
     var = cg.new_Pvariable(
         config[CONF_ID], prog_arr, width, height, IMAGE_TYPE[config[CONF_TYPE]]
     )
     cg.add(var.set_transparency(transparent))
+    if compression != "NONE":
+        cg.add(var.set_compression(IMAGE_COMPRESSION[compression]))
@@ -14,6 +14,7 @@ class InkbirdIbstH1Mini : public Component, public esp32_ble_tracker::ESPBTDevic
   void set_address(uint64_t address) { address_ = address; }
 
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
+  std::vector<uint64_t> get_address_filter() const override { return {this->address_}; }
 
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
@@ -25,10 +25,12 @@ void IntegrationSensor::dump_config() { LOG_SENSOR("", "Integration Sensor", thi
 void IntegrationSensor::process_sensor_value_(float value) {
   if (std::isnan(value))
     return;
-  const uint32_t now = millis();
+  // integrate over the time the samples were captured, not when they reached us
+  const uint32_t now = this->sensor_->get_state_timestamp();
   const double old_value = this->last_value_;
   const double new_value = value;
-  const uint32_t dt_ms = now - this->last_update_;
+  // a sample captured before the previous update (e.g. before setup) adds no area
+  const uint32_t dt_ms = int32_t(now - this->last_update_) > 0 ? now - this->last_update_ : 0;
   const double dt = dt_ms * this->get_time_factor_();
   double area = 0.0f;
   switch (this->method_) {
@@ -43,8 +45,9 @@ void IntegrationSensor::process_sensor_value_(float value) {
       break;
   }
   this->last_value_ = new_value;
-  this->last_update_ = now;
-  this->publish_and_save_(this->result_ + area);
+  if (dt_ms > 0)
+    this->last_update_ = now;
+  this->publish_and_save_(this->result_ + area, now);
 }
 
 }  // namespace integration
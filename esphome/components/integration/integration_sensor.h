@@ -52,9 +52,10 @@ class IntegrationSensor : public sensor::Sensor, public Component {
         return 0.0f;
     }
   }
-  void publish_and_save_(double result) {
+  void publish_and_save_(double result) { this->publish_and_save_(result, millis()); }
+  void publish_and_save_(double result, uint32_t timestamp) {
     this->result_ = result;
-    this->publish_state(result);
+    this->publish_state(result, timestamp);
     if (this->restore_) {
       float result_f = result;
       this->pref_.save(&result_f);
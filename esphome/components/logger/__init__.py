@@ -17,11 +17,14 @@ from esphome.const import (
     CONF_TAG,
     CONF_TRIGGER_ID,
     CONF_TX_BUFFER_SIZE,
+    KEY_CORE,
+    KEY_FRAMEWORK_VERSION,
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
     PLATFORM_RP2040,
 )
 from esphome.core import CORE, EsphomeError, Lambda, coroutine_with_priority
+from esphome.helpers import write_file_if_changed
 from esphome.components.esp32 import add_idf_sdkconfig_option, get_esp32_variant
 from esphome.components.esp32.const import (
     VARIANT_ESP32,
@@ -132,12 +135,35 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_ASYNC_BUFFER_SIZE = "async_buffer_size"
+CONF_BINARY_FORMAT = "binary_format"
+KEY_LOG_FORMATS = "log_formats"
+KEY_LOG_TAGS = "log_tags"
+
+
+def validate_async_buffer_size(config):
+    if CONF_ASYNC_BUFFER_SIZE in config:
+        if config[CONF_ASYNC_BUFFER_SIZE] < 2 * config[CONF_TX_BUFFER_SIZE]:
+            raise cv.Invalid(
+                f"{CONF_ASYNC_BUFFER_SIZE} must be at least twice the {CONF_TX_BUFFER_SIZE}",
+                path=[CONF_ASYNC_BUFFER_SIZE],
+            )
+        if config[CONF_BINARY_FORMAT]:
+            raise cv.Invalid(
+                f"{CONF_ASYNC_BUFFER_SIZE} cannot be used together with {CONF_BINARY_FORMAT}",
+                path=[CONF_BINARY_FORMAT],
+            )
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(Logger),
             cv.Optional(CONF_BAUD_RATE, default=115200): cv.positive_int,
             cv.Optional(CONF_TX_BUFFER_SIZE, default=512): cv.validate_bytes,
+            cv.Optional(CONF_ASYNC_BUFFER_SIZE): cv.validate_bytes,
+            cv.Optional(CONF_BINARY_FORMAT, default=False): cv.boolean,
             cv.Optional(CONF_DEASSERT_RTS_DTR, default=False): cv.boolean,
             cv.SplitDefault(
                 CONF_HARDWARE_UART,
@@ -166,6 +192,7 @@ CONFIG_SCHEMA = cv.All(
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
+    validate_async_buffer_size,
 )
 
 
@@ -179,10 +206,18 @@ async def to_code(config):
                 HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]]
             )
         )
-    cg.add(log.pre_setup())
-
+    if CONF_ASYNC_BUFFER_SIZE in config:
+        cg.add_define("USE_LOGGER_ASYNC")
+        cg.add(log.set_async_buffer_size(config[CONF_ASYNC_BUFFER_SIZE]))
+    if config[CONF_BINARY_FORMAT]:
+        cg.add_define("USE_LOGGER_BINARY")
+        CORE.add_job(_write_log_strings)
+    # Log statements cache the level of their tag once the logger is set up
     for tag, level in config[CONF_LOGS].items():
         cg.add(log.set_log_level(tag, LOG_LEVELS[level]))
+    if config[CONF_LOGS]:
+        cg.add_define("USE_LOGGER_TAG_LEVELS")
+    cg.add(log.pre_setup())
 
     level = config[CONF_LEVEL]
     cg.add_define("USE_LOGGER")
@@ -244,6 +279,33 @@ async def to_code(config):
         )
 
 
+@coroutine_with_priority(-1000.0)
+async def _write_log_strings():
+    # Runs last, when all components and their logger.log actions are known
+    from esphome.config import iter_components
+    from esphome.log_strings import build_string_table, pri_lengths_for
+
+    paths = set()
+    for _, component, _ in iter_components(CORE.config):
+        for resource in component.resources:
+            with resource.path() as path:
+                paths.add(path)
+    sources = [path.read_text(encoding="utf-8", errors="replace") for path in paths]
+    version = CORE.data[KEY_CORE].get(KEY_FRAMEWORK_VERSION)
+    pri_lengths = pri_lengths_for(
+        CORE.target_platform,
+        CORE.target_framework,
+        (version.major, version.minor, version.patch) if version else None,
+        get_esp32_variant() if CORE.is_esp32 else None,
+    )
+    table = build_string_table(sources, pri_lengths, CORE.data.get(KEY_LOG_FORMATS, ()))
+    for tag in CORE.data.get(KEY_LOG_TAGS, ()):
+        table.add_tag(tag)
+    write_file_if_changed(
+        CORE.relative_build_path("log_strings.json"), table.to_json()
+    )
+
+
 def validate_printf(value):
     # https://stackoverflow.com/questions/30011379/how-can-i-parse-a-c-format-string-in-python
     cfmt = r"""
@@ -284,6 +346,8 @@ LOGGER_LOG_ACTION_SCHEMA = cv.All(
 @automation.register_action(CONF_LOGGER_LOG, LambdaAction, LOGGER_LOG_ACTION_SCHEMA)
 async def logger_log_action_to_code(config, action_id, template_arg, args):
     esp_log = LOG_LEVEL_TO_ESP_LOG[config[CONF_LEVEL]]
+    CORE.data.setdefault(KEY_LOG_FORMATS, set()).add(config[CONF_FORMAT])
+    CORE.data.setdefault(KEY_LOG_TAGS, set()).add(config[CONF_TAG])
     args_ = [cg.RawExpression(str(x)) for x in config[CONF_ARGS]]
 
     text = str(cg.statement(esp_log(config[CONF_TAG], config[CONF_FORMAT], *args_)))
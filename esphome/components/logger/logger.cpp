@@ -1,4 +1,5 @@
 #include "logger.h"
+#include <algorithm>
 #include <cinttypes>
 
 #ifdef USE_ESP_IDF
@@ -17,6 +18,11 @@ namespace logger {
 
 static const char *const TAG = "logger";
 
+#ifdef USE_LOGGER_ASYNC
+/// Time the main loop spends at most writing out buffered messages per iteration.
+static const uint32_t ASYNC_DRAIN_BUDGET_MS = 5;
+#endif
+
 static const char *const LOG_LEVEL_COLORS[] = {
     "",                                            // NONE
     ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED),       // ERROR
@@ -49,22 +55,213 @@ void Logger::write_header_(int level, const char *tag, int line) {
   this->printf_to_buffer_("%s[%s][%s:%03u]: ", color, letter, tag, line);
 }
 
+#ifdef USE_LOGGER_ASYNC
+void LogRingBuffer::init(size_t size) {
+  // keep records aligned for their tag pointer
+  this->size_ = size - size % alignof(Record);
+  this->data_ = new uint8_t[this->size_];  // NOLINT(cppcoreguidelines-owning-memory)
+}
+size_t LogRingBuffer::record_size_(size_t length) {
+  // add 1 for the null terminator and round up to the alignment of the next record
+  size_t size = sizeof(Record) + length + 1;
+  return (size + alignof(Record) - 1) / alignof(Record) * alignof(Record);
+}
+LogRingBuffer::Record *LogRingBuffer::reserve(size_t max_length) {
+  const size_t size = record_size_(max_length);
+  LockGuard guard{this->lock_};
+  if (this->data_ == nullptr)
+    return nullptr;
+
+  // records are contiguous, so the space left at the end is skipped if the record doesn't fit there
+  size_t skip = this->head_ + size > this->size_ ? this->size_ - this->head_ : 0;
+  if (this->used_ + skip + size > this->size_) {
+    this->dropped_++;
+    return nullptr;
+  }
+  if (skip != 0) {
+    if (skip >= sizeof(Record)) {
+      auto *padding = reinterpret_cast<Record *>(this->data_ + this->head_);
+      padding->size = skip;
+      padding->ready = true;
+      padding->tag = nullptr;
+    }
+    this->used_ += skip;
+    this->head_ = 0;
+  }
+
+  auto *record = reinterpret_cast<Record *>(this->data_ + this->head_);
+  record->size = size;
+  record->ready = false;
+  this->head_ += size;
+  this->used_ += size;
+  if (this->head_ == this->size_)
+    this->head_ = 0;
+  return record;
+}
+void LogRingBuffer::commit(Record *record, size_t length) {
+  LockGuard guard{this->lock_};
+  // give back what the message didn't use, unless another record was reserved after this one
+  const size_t size = record_size_(length);
+  if (reinterpret_cast<uint8_t *>(record) + record->size == this->data_ + this->head_) {
+    this->head_ -= record->size - size;
+    this->used_ -= record->size - size;
+    record->size = size;
+  }
+  record->ready = true;
+}
+LogRingBuffer::Record *LogRingBuffer::front() {
+  LockGuard guard{this->lock_};
+  while (this->used_ != 0) {
+    if (this->size_ - this->tail_ < sizeof(Record)) {
+      // too little space left at the end for a record, skipped by reserve()
+      this->used_ -= this->size_ - this->tail_;
+      this->tail_ = 0;
+      continue;
+    }
+    auto *record = reinterpret_cast<Record *>(this->data_ + this->tail_);
+    if (!record->ready)
+      return nullptr;
+    if (record->tag != nullptr)
+      return record;
+    // padding at the end of the buffer
+    this->used_ -= record->size;
+    this->tail_ = 0;
+  }
+  return nullptr;
+}
+void LogRingBuffer::pop() {
+  LockGuard guard{this->lock_};
+  auto *record = reinterpret_cast<Record *>(this->data_ + this->tail_);
+  this->tail_ += record->size;
+  this->used_ -= record->size;
+  if (this->tail_ == this->size_)
+    this->tail_ = 0;
+}
+uint32_t LogRingBuffer::take_dropped() {
+  LockGuard guard{this->lock_};
+  uint32_t dropped = this->dropped_;
+  this->dropped_ = 0;
+  return dropped;
+}
+
+bool Logger::is_main_task_() const {
+#if defined(USE_ESP32)
+  return xTaskGetCurrentTaskHandle() == this->main_task_;
+#elif defined(USE_HOST)
+  return std::this_thread::get_id() == this->main_thread_;
+#else
+  return true;
+#endif
+}
+
+void HOT Logger::log_async_(int level, const char *tag, int line, const char *format, va_list args) {
+  auto *record = this->log_buffer_.reserve(this->tx_buffer_size_);
+  if (record == nullptr)
+    return;
+
+  const int clamped = level < 0 ? 0 : (level > 7 ? 7 : level);
+  char *msg = record->message();
+  const int size = this->tx_buffer_size_ + 1;
+  int at = snprintf(msg, size, "%s[%s][%s:%03u]: ", LOG_LEVEL_COLORS[clamped], LOG_LEVEL_LETTERS[clamped], tag, line);
+  if (at >= 0 && at < size) {
+    int ret = vsnprintf(msg + at, size - at, format, args);
+    if (ret > 0)
+      at = std::min(at + ret, size - 1);
+  }
+  at = std::max(std::min(at, size - 1), 0);
+  // remove trailing newline
+  if (at > 0 && msg[at - 1] == '\n')
+    at--;
+  const size_t reset_len = strlen(ESPHOME_LOG_RESET_COLOR);
+  if (at + reset_len < static_cast<size_t>(size)) {
+    memcpy(msg + at, ESPHOME_LOG_RESET_COLOR, reset_len);
+    at += reset_len;
+  }
+  msg[at] = '\0';
+
+  record->level = clamped;
+  record->tag = tag;
+  this->log_buffer_.commit(record, at);
+}
+
+void Logger::loop() {
+  // Messages of the main task are buffered once it runs the loop, until then they are written out directly.
+  this->async_active_ = true;
+  this->write_buffered_(ASYNC_DRAIN_BUDGET_MS);
+}
+void Logger::on_shutdown() {
+  // write out everything before the reboot
+  this->write_buffered_(UINT32_MAX);
+  this->async_active_ = false;
+}
+void Logger::write_buffered_(uint32_t budget_ms) {
+  const uint32_t start = millis();
+  this->recursion_guard_ = true;
+  uint32_t dropped = this->log_buffer_.take_dropped();
+  if (dropped != 0) {
+    this->reset_buffer_();
+    this->write_header_(ESPHOME_LOG_LEVEL_WARN, TAG, __LINE__);
+    this->printf_to_buffer_("%" PRIu32 " log messages dropped, the buffer was full", dropped);
+    this->write_footer_();
+    this->log_message_(ESPHOME_LOG_LEVEL_WARN, TAG);
+  }
+  LogRingBuffer::Record *record;
+  while ((record = this->log_buffer_.front()) != nullptr) {
+    this->write_message_(record->level, record->tag, record->message());
+    this->log_buffer_.pop();
+    // leave the rest to the next loop iteration if the UART or the listeners are slow
+    if (millis() - start >= budget_ms)
+      break;
+  }
+  this->recursion_guard_ = false;
+}
+#endif  // USE_LOGGER_ASYNC
+
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+  this->log_enabled_vprintf_(level, tag, line, format, args);
+}
+void HOT Logger::log_enabled_vprintf_(int level, const char *tag, int line, const char *format,
+                                      va_list args) {  // NOLINT
+#ifdef USE_LOGGER_ASYNC
+  if (!this->is_main_task_() || (this->async_active_ && !this->recursion_guard_)) {
+    this->log_async_(level, tag, line, format, args);
+    return;
+  }
+#endif
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
+#ifdef USE_LOGGER_BINARY
+  const bool binary_sent = this->log_binary_(level, tag, line, format, format, args);
+  if (binary_sent && !this->needs_text_()) {
+    recursion_guard_ = false;
+    return;
+  }
+#endif
   this->reset_buffer_();
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(format, args);
   this->write_footer_();
   this->log_message_(level, tag);
+#ifdef USE_LOGGER_BINARY
+  if (!binary_sent)
+    this->log_binary_text_(level, tag, line, 0);
+#endif
   recursion_guard_ = false;
 }
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,
                           va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+  this->log_enabled_vprintf_(level, tag, line, format, args);
+}
+void Logger::log_enabled_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,
+                                  va_list args) {  // NOLINT
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
@@ -77,21 +274,254 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
     this->tx_buffer_[this->tx_buffer_at_++] = ch = (char) progmem_read_byte(format_pgm_p++);
   }
   // Buffer full form copying format
-  if (this->is_buffer_full_())
+  if (this->is_buffer_full_()) {
+    recursion_guard_ = false;
     return;
+  }
 
   // length of format string, includes null terminator
   uint32_t offset = this->tx_buffer_at_;
 
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_active_) {
+    this->log_async_(level, tag, line, this->tx_buffer_, args);
+    recursion_guard_ = false;
+    return;
+  }
+#endif
+#ifdef USE_LOGGER_BINARY
+  const bool binary_sent = this->log_binary_(level, tag, line, format, this->tx_buffer_, args);
+  if (binary_sent && !this->needs_text_()) {
+    recursion_guard_ = false;
+    return;
+  }
+#endif
+
   // now apply vsnprintf
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(this->tx_buffer_, args);
   this->write_footer_();
   this->log_message_(level, tag, offset);
+#ifdef USE_LOGGER_BINARY
+  if (!binary_sent)
+    this->log_binary_text_(level, tag, line, offset);
+#endif
   recursion_guard_ = false;
 }
 #endif
 
+#ifdef USE_LOGGER_BINARY
+// FNV-1 hash of a format string or tag, mirrored by the code generator that writes the string table.
+static uint32_t log_string_id(const char *str) {
+  uint32_t hash = 2166136261UL;
+  for (; *str != '\0'; str++) {
+    hash *= 16777619UL;
+    hash ^= static_cast<uint8_t>(*str);
+  }
+  return hash;
+}
+
+/** Pack the arguments of a printf format string for the binary log format.
+ *
+ * Integers (including `*` widths and precisions) are written as varints, signed ones zigzag encoded, floating point
+ * values as little endian doubles and strings null terminated. Packing stops at a conversion it doesn't know or when
+ * out is full, the decoder shows the missing arguments as such.
+ */
+static size_t pack_log_args(const char *format, va_list args, uint8_t *out, size_t size) {
+  size_t at = 0;
+  auto put_unsigned = [&](uint64_t value) {
+    do {
+      if (at == size)
+        return false;
+      uint8_t byte = value & 0x7F;
+      value >>= 7;
+      out[at++] = value != 0 ? byte | 0x80 : byte;
+    } while (value != 0);
+    return true;
+  };
+  auto put_signed = [&](int64_t value) {
+    return put_unsigned((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  };
+
+  for (const char *p = format; *p != '\0'; p++) {
+    if (*p != '%')
+      continue;
+    p++;
+    if (*p == '%')
+      continue;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+      p++;
+    if (*p == '*') {
+      if (!put_signed(va_arg(args, int)))
+        return at;
+      p++;
+    }
+    while (*p >= '0' && *p <= '9')
+      p++;
+    int precision = -1;
+    if (*p == '.') {
+      p++;
+      precision = 0;
+      if (*p == '*') {
+        precision = va_arg(args, int);
+        if (!put_signed(precision))
+          return at;
+        p++;
+      }
+      while (*p >= '0' && *p <= '9')
+        precision = precision * 10 + (*p++ - '0');
+    }
+    // length modifiers: 'h' and 'hh' are promoted to int, 'l' twice means long long
+    int longs = 0;
+    char size_type = '\0';
+    while (*p == 'h' || *p == 'l' || *p == 'L' || *p == 'j' || *p == 'z' || *p == 't') {
+      if (*p == 'l') {
+        longs++;
+      } else if (*p != 'h') {
+        size_type = *p;
+      }
+      p++;
+    }
+
+    bool ok;
+    switch (*p) {
+      case 'd':
+      case 'i':
+        if (size_type == 'j') {
+          ok = put_signed(va_arg(args, intmax_t));
+        } else if (size_type == 'z' || size_type == 't') {
+          ok = put_signed(va_arg(args, ptrdiff_t));
+        } else if (longs >= 2) {
+          ok = put_signed(va_arg(args, long long));
+        } else if (longs == 1) {
+          ok = put_signed(va_arg(args, long));
+        } else {
+          ok = put_signed(va_arg(args, int));
+        }
+        break;
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+        if (size_type == 'j') {
+          ok = put_unsigned(va_arg(args, uintmax_t));
+        } else if (size_type == 'z' || size_type == 't') {
+          ok = put_unsigned(va_arg(args, size_t));
+        } else if (longs >= 2) {
+          ok = put_unsigned(va_arg(args, unsigned long long));
+        } else if (longs == 1) {
+          ok = put_unsigned(va_arg(args, unsigned long));
+        } else {
+          ok = put_unsigned(va_arg(args, unsigned int));
+        }
+        break;
+      case 'c':
+        ok = put_unsigned(static_cast<uint8_t>(va_arg(args, int)));
+        break;
+      case 'p':
+        ok = put_unsigned(reinterpret_cast<uintptr_t>(va_arg(args, void *)));
+        break;
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A': {
+        double value = size_type == 'L' ? static_cast<double>(va_arg(args, long double)) : va_arg(args, double);
+        ok = at + sizeof(value) <= size;
+        if (ok) {
+          uint64_t bits;
+          memcpy(&bits, &value, sizeof(bits));
+          for (size_t i = 0; i < sizeof(bits); i++)
+            out[at++] = bits >> (i * 8);
+        }
+        break;
+      }
+      case 's': {
+        const char *value = va_arg(args, const char *);
+        if (value == nullptr)
+          value = "(null)";
+        size_t len = strlen(value);
+        if (precision >= 0 && static_cast<size_t>(precision) < len)
+          len = precision;
+        ok = at + len + 1 <= size;
+        if (ok) {
+          memcpy(out + at, value, len);
+          at += len;
+          out[at++] = '\0';
+        }
+        break;
+      }
+      case 'n':
+        va_arg(args, int *);
+        ok = true;
+        break;
+      default:
+        ok = false;
+        break;
+    }
+    if (!ok || *p == '\0')
+      break;
+  }
+  return at;
+}
+
+uint32_t Logger::string_id_(const void *key, const char *str) {
+  auto &entry = this->string_ids_[(reinterpret_cast<uintptr_t>(key) >> 2) % STRING_ID_CACHE_SIZE];
+  if (entry.key != key) {
+    entry.key = key;
+    entry.id = log_string_id(str);
+  }
+  return entry.id;
+}
+
+bool Logger::needs_text_() const {
+#ifdef USE_HOST
+  return true;
+#else
+  return this->baud_rate_ > 0 || !this->log_callback_.empty();
+#endif
+}
+
+bool HOT Logger::log_binary_(int level, const char *tag, int line, const void *format_key, const char *format,
+                             va_list args) {
+  // messages from the esp-idf log hook use format strings the string table doesn't know, they are sent as text
+  if (this->binary_log_callback_.empty() || line == 0)
+    return false;
+
+  va_list copy;
+  va_copy(copy, args);
+  BinaryLogMessage msg{};
+  msg.level = level;
+  msg.tag_id = this->string_id_(tag, tag);
+  msg.format_id = this->string_id_(format_key, format);
+  msg.line = line;
+  msg.args = this->binary_buffer_;
+  msg.args_len = pack_log_args(format, copy, this->binary_buffer_, this->tx_buffer_size_);
+  va_end(copy);
+  this->binary_log_callback_.call(msg);
+  return true;
+}
+
+void Logger::log_binary_text_(int level, const char *tag, int line, int offset) {
+  if (this->binary_log_callback_.empty())
+    return;
+  BinaryLogMessage msg{};
+  msg.level = level;
+  msg.tag_id = this->string_id_(tag, tag);
+  msg.line = line;
+  msg.args = reinterpret_cast<const uint8_t *>(this->tx_buffer_ + offset);
+  msg.args_len = this->tx_buffer_at_ - offset;
+  this->binary_log_callback_.call(msg);
+}
+
+void Logger::add_on_binary_log_callback(std::function<void(const BinaryLogMessage &)> &&callback) {
+  this->binary_log_callback_.add(std::move(callback));
+}
+#endif  // USE_LOGGER_BINARY
+
 int HOT Logger::level_for(const char *tag) {
   // Uses std::vector<> for low memory footprint, though the vector
   // could be sorted to minimize lookup times. This feature isn't used that
@@ -111,7 +541,9 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   // make sure null terminator is present
   this->set_null_terminator_();
 
-  const char *msg = this->tx_buffer_ + offset;
+  this->write_message_(level, tag, this->tx_buffer_ + offset);
+}
+void HOT Logger::write_message_(int level, const char *tag, const char *msg) {
   if (this->baud_rate_ > 0) {
 #ifdef USE_ARDUINO
     this->hw_serial_->println(msg);
@@ -155,6 +587,9 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size) {
   // add 1 to buffer size for null terminator
   this->tx_buffer_ = new char[this->tx_buffer_size_ + 1];  // NOLINT
+#ifdef USE_LOGGER_BINARY
+  this->binary_buffer_ = new uint8_t[this->tx_buffer_size_];  // NOLINT
+#endif
 }
 
 void Logger::pre_setup() {
@@ -251,6 +686,14 @@ void Logger::pre_setup() {
   }
 #endif  // USE_ESP8266
 
+#ifdef USE_LOGGER_ASYNC
+#if defined(USE_ESP32)
+  this->main_task_ = xTaskGetCurrentTaskHandle();
+#elif defined(USE_HOST)
+  this->main_thread_ = std::this_thread::get_id();
+#endif
+#endif  // USE_LOGGER_ASYNC
+
   global_logger = this;
 #if defined(USE_ESP_IDF) || defined(USE_ESP32_FRAMEWORK_ARDUINO)
   esp_log_set_vprintf(esp_idf_log_vprintf_);
@@ -21,10 +21,84 @@
 #include <driver/uart.h>
 #endif  // USE_ESP_IDF
 
+#ifdef USE_LOGGER_ASYNC
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif  // USE_ESP32
+#ifdef USE_HOST
+#include <thread>
+#endif  // USE_HOST
+#endif  // USE_LOGGER_ASYNC
+
 namespace esphome {
 
 namespace logger {
 
+#ifdef USE_LOGGER_BINARY
+/** A log message in the binary format: the text is rebuilt off-device from the format string and tag with these
+ * IDs in the string table written by the code generator.
+ *
+ * Messages that can't be sent this way have a format_id of 0 and carry the formatted text in args instead.
+ */
+struct BinaryLogMessage {
+  int level;
+  uint32_t tag_id;
+  uint32_t format_id;
+  int line;
+  /// The packed arguments of the format string.
+  const uint8_t *args;
+  size_t args_len;
+};
+#endif  // USE_LOGGER_BINARY
+
+#ifdef USE_LOGGER_ASYNC
+/** Ring buffer of formatted log records, written by any task and drained by the main loop.
+ *
+ * The lock is only held to move the indices: a producer reserves room for a whole record, formats into it
+ * without holding the lock and then commits it. Records are drained in order, so the consumer waits for a
+ * record that is still being formatted.
+ */
+class LogRingBuffer {
+ public:
+  struct Record {
+    /// Bytes taken by this record in the buffer, including this header.
+    uint32_t size;
+    uint8_t level;
+    bool ready;
+    /// Tag of the message, nullptr for the padding at the end of the buffer.
+    const char *tag;
+
+    char *message() { return reinterpret_cast<char *>(this + 1); }
+  };
+
+  void init(size_t size);
+  bool is_initialized() const { return this->data_ != nullptr; }
+
+  /// Reserve room for a record with a message of up to max_length characters, nullptr if the buffer is full.
+  Record *reserve(size_t max_length);
+  /// Publish a reserved record with a message of length characters to the consumer.
+  void commit(Record *record, size_t length);
+  /// Get the oldest record if it has been committed.
+  Record *front();
+  /// Release the record returned by front().
+  void pop();
+  /// Get and reset the number of records that did not fit into the buffer.
+  uint32_t take_dropped();
+
+ protected:
+  static size_t record_size_(size_t length);
+
+  uint8_t *data_{nullptr};
+  size_t size_{0};
+  size_t head_{0};
+  size_t tail_{0};
+  size_t used_{0};
+  uint32_t dropped_{0};
+  Mutex lock_;
+};
+#endif  // USE_LOGGER_ASYNC
+
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040)
 /** Enum for logging UART selection
  *
@@ -74,7 +148,7 @@ class Logger : public Component {
   UARTSelection get_uart() const;
 #endif
 
-  /// Set the log level of the specified tag.
+  /// Set the log level of the specified tag, log statements look it up once after pre_setup().
   void set_log_level(const std::string &tag, int log_level);
 
   // ========== INTERNAL METHODS ==========
@@ -82,11 +156,25 @@ class Logger : public Component {
   /// Set up this component.
   void pre_setup();
   void dump_config() override;
+#ifdef USE_LOGGER_ASYNC
+  /// Format log messages into a ring buffer of this size and write them out from the main loop.
+  void set_async_buffer_size(size_t size) { this->log_buffer_.init(size); }
+  void loop() override;
+  void on_shutdown() override;
+#endif
 
   int level_for(const char *tag);
 
   /// Register a callback that will be called for every log message sent
   void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
+#ifdef USE_LOGGER_BINARY
+  /** Register a callback that will be called for every log message in the binary format.
+   *
+   * Messages are only formatted as text on the device if the serial port is enabled or a callback was registered
+   * with add_on_log_callback(), so listeners that can do with the binary format should register only this one.
+   */
+  void add_on_binary_log_callback(std::function<void(const BinaryLogMessage &)> &&callback);
+#endif
 
   float get_setup_priority() const override;
 
@@ -94,11 +182,32 @@ class Logger : public Component {
 #ifdef USE_STORE_LOG_STR_IN_FLASH
   void log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format, va_list args);  // NOLINT
 #endif
+  /// Like log_vprintf_(), for messages whose level was already checked against the level of their tag.
+  void log_enabled_vprintf_(int level, const char *tag, int line, const char *format, va_list args);  // NOLINT
+#ifdef USE_STORE_LOG_STR_IN_FLASH
+  void log_enabled_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,  // NOLINT
+                            va_list args);
+#endif
 
  protected:
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+  void write_message_(int level, const char *tag, const char *msg);
+#ifdef USE_LOGGER_BINARY
+  bool needs_text_() const;
+  uint32_t string_id_(const void *key, const char *str);
+  /// Send the message in the binary format, returns false if it has to be sent as text.
+  bool log_binary_(int level, const char *tag, int line, const void *format_key, const char *format, va_list args);
+  /// Send the message formatted in tx_buffer_ to the binary listeners.
+  void log_binary_text_(int level, const char *tag, int line, int offset);
+#endif
+#ifdef USE_LOGGER_ASYNC
+  bool is_main_task_() const;
+  /// Write out buffered messages until none are left or budget_ms have passed.
+  void write_buffered_(uint32_t budget_ms);
+  void log_async_(int level, const char *tag, int line, const char *format, va_list args);
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -159,6 +268,28 @@ class Logger : public Component {
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
+#ifdef USE_LOGGER_BINARY
+  static const size_t STRING_ID_CACHE_SIZE = 32;
+  struct StringIdCacheEntry {
+    const void *key;
+    uint32_t id;
+  };
+  /// IDs of recently used format strings and tags, by their address.
+  StringIdCacheEntry string_ids_[STRING_ID_CACHE_SIZE]{};
+  uint8_t *binary_buffer_{nullptr};
+  CallbackManager<void(const BinaryLogMessage &)> binary_log_callback_{};
+#endif
+#ifdef USE_LOGGER_ASYNC
+  LogRingBuffer log_buffer_;
+  /// Whether the main loop is running and messages of the main task are buffered as well.
+  bool async_active_{false};
+#ifdef USE_ESP32
+  TaskHandle_t main_task_{nullptr};
+#endif
+#ifdef USE_HOST
+  std::thread::id main_thread_;
+#endif
+#endif  // USE_LOGGER_ASYNC
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
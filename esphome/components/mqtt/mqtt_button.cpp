@@ -32,8 +32,8 @@ void MQTTButtonComponent::dump_config() {
 
 void MQTTButtonComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
   config.state_topic = false;
-  if (!this->button_->get_device_class().empty())
-    root[MQTT_DEVICE_CLASS] = this->button_->get_device_class();
+  if (!this->button_->get_device_class_ref().empty())
+    root[MQTT_DEVICE_CLASS] = this->button_->get_device_class_ref();
 }
 
 std::string MQTTButtonComponent::component_type() const { return "button"; }
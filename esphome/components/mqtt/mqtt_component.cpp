@@ -74,8 +74,9 @@ bool MQTTComponent::send_discovery_() {
         root[MQTT_NAME] = this->friendly_name();
         if (this->is_disabled_by_default())
           root[MQTT_ENABLED_BY_DEFAULT] = false;
-        if (!this->get_icon().empty())
-          root[MQTT_ICON] = this->get_icon();
+        const std::string icon = this->get_icon();
+        if (!icon.empty())
+          root[MQTT_ICON] = icon;
 
         switch (this->get_entity()->get_entity_category()) {
           case ENTITY_CATEGORY_NONE:
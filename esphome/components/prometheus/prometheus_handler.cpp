@@ -3,350 +3,465 @@
 #include "prometheus_handler.h"
 #include "esphome/core/application.h"
 
+#include <cmath>
+#include <cstring>
+
 namespace esphome {
 namespace prometheus {
 
-void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
+// Append the unsigned integer value to out.
+static void append_uint(std::string &out, uint32_t value) {
+  char buf[10];
+  char *end = buf + sizeof(buf);
+  char *p = end;
+  do {
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  out.append(p, end - p);
+}
+
+// Append value with the given number of decimals to out, producing the same text as value_accuracy_to_string()
+// for the values sensors normally report without going through printf.
+static void append_value(std::string &out, float value, int8_t accuracy_decimals) {
+  static const uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+  if (accuracy_decimals < 0) {
+    auto multiplier = powf(10.0f, accuracy_decimals);
+    value = roundf(value * multiplier) / multiplier;
+    accuracy_decimals = 0;
+  }
+  if (!std::isfinite(value) || accuracy_decimals > 6 || fabsf(value) >= 1e9f) {
+    char tmp[32];
+    snprintf(tmp, sizeof(tmp), "%.*f", accuracy_decimals, value);
+    out += tmp;
+    return;
+  }
+
+  // A float times at most 10^6 is exact in a double, so rounding half to even here matches printf.
+  const uint32_t divisor = POW10[accuracy_decimals];
+  const auto scaled = static_cast<uint64_t>(std::nearbyint(std::fabs(static_cast<double>(value)) * divisor));
+  // printf keeps the sign of negative values that round to zero, and of -0.0
+  if (std::signbit(value))
+    out += '-';
+
+  uint64_t integer = scaled / divisor;
+  uint32_t fraction = scaled % divisor;
+  char buf[20];
+  char *end = buf + sizeof(buf);
+  char *p = end;
+  do {
+    *--p = static_cast<char>('0' + integer % 10);
+    integer /= 10;
+  } while (integer != 0);
+  out.append(p, end - p);
+
+  if (accuracy_decimals > 0) {
+    out += '.';
+    for (int8_t i = accuracy_decimals - 1; i >= 0; i--) {
+      buf[i] = static_cast<char>('0' + fraction % 10);
+      fraction /= 10;
+    }
+    out.append(buf, accuracy_decimals);
+  }
+}
 
+// Append value to out as a label value, escaped as required by the text exposition format.
+static void append_label_value(std::string &out, const StringRef &value) {
+  for (char c : value) {
+    switch (c) {
+      case '\\':
+        out += "\\\\";
+        break;
+      case '"':
+        out += "\\\"";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      default:
+        out += c;
+        break;
+    }
+  }
+}
+
+// Append the start of a data point of the metric, up to and including its labels.
+static void append_metric(std::string &out, const char *metric, const std::string &labels) {
+  out += metric;
+  out += '{';
+  out += labels;
+}
+
+void PrometheusHandler::setup() {
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
+  this->add_row_(ROW_TYPE_SENSOR, nullptr);
   for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj);
+    this->add_row_(ROW_TYPE_SENSOR, obj);
 #endif
 
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
+  this->add_row_(ROW_TYPE_BINARY_SENSOR, nullptr);
   for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj);
+    this->add_row_(ROW_TYPE_BINARY_SENSOR, obj);
 #endif
 
 #ifdef USE_FAN
-  this->fan_type_(stream);
+  this->add_row_(ROW_TYPE_FAN, nullptr);
   for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj);
+    this->add_row_(ROW_TYPE_FAN, obj);
 #endif
 
 #ifdef USE_LIGHT
-  this->light_type_(stream);
+  this->add_row_(ROW_TYPE_LIGHT, nullptr);
   for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj);
+    this->add_row_(ROW_TYPE_LIGHT, obj);
 #endif
 
 #ifdef USE_COVER
-  this->cover_type_(stream);
+  this->add_row_(ROW_TYPE_COVER, nullptr);
   for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj);
+    this->add_row_(ROW_TYPE_COVER, obj);
 #endif
 
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
+  this->add_row_(ROW_TYPE_SWITCH, nullptr);
   for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj);
+    this->add_row_(ROW_TYPE_SWITCH, obj);
 #endif
 
 #ifdef USE_LOCK
-  this->lock_type_(stream);
+  this->add_row_(ROW_TYPE_LOCK, nullptr);
   for (auto *obj : App.get_locks())
-    this->lock_row_(stream, obj);
+    this->add_row_(ROW_TYPE_LOCK, obj);
 #endif
 
-  req->send(stream);
+  // The labels never change, so the lookup tables are not needed anymore.
+  this->relabel_map_id_.clear();
+  this->relabel_map_name_.clear();
+
+  this->base_->init();
+  this->base_->add_handler(this);
 }
 
-std::string PrometheusHandler::relabel_id_(EntityBase *obj) {
+void PrometheusHandler::add_row_(RowType type, EntityBase *obj) {
+  Row row{type, obj, {}};
+  if (obj != nullptr) {
+    if (obj->is_internal() && !this->include_internal_)
+      return;
+    row.labels = "id=\"";
+    append_label_value(row.labels, this->relabel_id_(obj));
+    row.labels += "\",name=\"";
+    append_label_value(row.labels, this->relabel_name_(obj));
+    row.labels += '"';
+    row.labels.shrink_to_fit();
+  }
+  this->rows_.push_back(std::move(row));
+}
+
+void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
+  // Rows are rendered one at a time into the TCP send buffer as it drains, so a scrape neither builds the whole
+  // response in memory nor blocks the main loop until it is sent. Each request keeps its own cursor.
+  auto cursor = std::make_shared<ExportCursor>();
+  AsyncWebServerResponse *response = req->beginChunkedResponse(
+      "text/plain; version=0.0.4; charset=utf-8",
+      [this, cursor](uint8_t *buffer, size_t max_len, size_t index) -> size_t {
+        return this->fill_(*cursor, buffer, max_len);
+      });
+  req->send(response);
+}
+
+size_t PrometheusHandler::fill_(ExportCursor &cursor, uint8_t *buffer, size_t max_len) {
+  size_t written = 0;
+  while (written < max_len) {
+    if (cursor.pending_pos == cursor.pending.size()) {
+      if (cursor.row == this->rows_.size())
+        break;
+      cursor.pending.clear();
+      cursor.pending_pos = 0;
+      this->render_row_(cursor.pending, this->rows_[cursor.row++]);
+      continue;
+    }
+    size_t len = std::min(max_len - written, cursor.pending.size() - cursor.pending_pos);
+    memcpy(buffer + written, cursor.pending.data() + cursor.pending_pos, len);
+    written += len;
+    cursor.pending_pos += len;
+  }
+  return written;
+}
+
+void PrometheusHandler::render_row_(std::string &out, const Row &row) {
+  switch (row.type) {
+#ifdef USE_SENSOR
+    case ROW_TYPE_SENSOR:
+      if (row.obj == nullptr) {
+        this->sensor_type_(out);
+      } else {
+        this->sensor_row_(out, static_cast<sensor::Sensor *>(row.obj), row.labels);
+      }
+      break;
+#endif
+#ifdef USE_BINARY_SENSOR
+    case ROW_TYPE_BINARY_SENSOR:
+      if (row.obj == nullptr) {
+        this->binary_sensor_type_(out);
+      } else {
+        this->binary_sensor_row_(out, static_cast<binary_sensor::BinarySensor *>(row.obj), row.labels);
+      }
+      break;
+#endif
+#ifdef USE_FAN
+    case ROW_TYPE_FAN:
+      if (row.obj == nullptr) {
+        this->fan_type_(out);
+      } else {
+        this->fan_row_(out, static_cast<fan::Fan *>(row.obj), row.labels);
+      }
+      break;
+#endif
+#ifdef USE_LIGHT
+    case ROW_TYPE_LIGHT:
+      if (row.obj == nullptr) {
+        this->light_type_(out);
+      } else {
+        this->light_row_(out, static_cast<light::LightState *>(row.obj), row.labels);
+      }
+      break;
+#endif
+#ifdef USE_COVER
+    case ROW_TYPE_COVER:
+      if (row.obj == nullptr) {
+        this->cover_type_(out);
+      } else {
+        this->cover_row_(out, static_cast<cover::Cover *>(row.obj), row.labels);
+      }
+      break;
+#endif
+#ifdef USE_SWITCH
+    case ROW_TYPE_SWITCH:
+      if (row.obj == nullptr) {
+        this->switch_type_(out);
+      } else {
+        this->switch_row_(out, static_cast<switch_::Switch *>(row.obj), row.labels);
+      }
+      break;
+#endif
+#ifdef USE_LOCK
+    case ROW_TYPE_LOCK:
+      if (row.obj == nullptr) {
+        this->lock_type_(out);
+      } else {
+        this->lock_row_(out, static_cast<lock::Lock *>(row.obj), row.labels);
+      }
+      break;
+#endif
+    default:
+      break;
+  }
+}
+
+StringRef PrometheusHandler::relabel_id_(EntityBase *obj) {
   auto item = relabel_map_id_.find(obj);
-  return item == relabel_map_id_.end() ? obj->get_object_id() : item->second;
+  return item == relabel_map_id_.end() ? obj->get_object_id_ref() : StringRef(item->second);
 }
 
-std::string PrometheusHandler::relabel_name_(EntityBase *obj) {
+StringRef PrometheusHandler::relabel_name_(EntityBase *obj) {
   auto item = relabel_map_name_.find(obj);
-  return item == relabel_map_name_.end() ? obj->get_name() : item->second;
+  return item == relabel_map_name_.end() ? obj->get_name() : StringRef(item->second);
 }
 
 // Type-specific implementation
 #ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_sensor_failed GAUGE\n"));
+void PrometheusHandler::sensor_type_(std::string &out) {
+  out += "#TYPE esphome_sensor_value GAUGE\n"
+         "#TYPE esphome_sensor_failed GAUGE\n";
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::sensor_row_(std::string &out, sensor::Sensor *obj, const std::string &labels) {
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    append_metric(out, "esphome_sensor_failed", labels);
+    out += "} 0\n";
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
-    stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print('\n');
+    append_metric(out, "esphome_sensor_value", labels);
+    out += ",unit=\"";
+    out += obj->get_unit_of_measurement_ref();
+    out += "\"} ";
+    append_value(out, obj->state, obj->get_accuracy_decimals());
+    out += '\n';
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    append_metric(out, "esphome_sensor_failed", labels);
+    out += "} 1\n";
   }
 }
 #endif
 
 // Type-specific implementation
 #ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_binary_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_binary_sensor_failed GAUGE\n"));
+void PrometheusHandler::binary_sensor_type_(std::string &out) {
+  out += "#TYPE esphome_binary_sensor_value GAUGE\n"
+         "#TYPE esphome_binary_sensor_failed GAUGE\n";
 }
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj,
+                                           const std::string &labels) {
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    append_metric(out, "esphome_binary_sensor_failed", labels);
+    out += "} 0\n";
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->state);
-    stream->print('\n');
+    append_metric(out, "esphome_binary_sensor_value", labels);
+    out += "} ";
+    append_uint(out, obj->state);
+    out += '\n';
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    append_metric(out, "esphome_binary_sensor_failed", labels);
+    out += "} 1\n";
   }
 }
 #endif
 
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_fan_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_failed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_speed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_oscillation GAUGE\n"));
+void PrometheusHandler::fan_type_(std::string &out) {
+  out += "#TYPE esphome_fan_value GAUGE\n"
+         "#TYPE esphome_fan_failed GAUGE\n"
+         "#TYPE esphome_fan_speed GAUGE\n"
+         "#TYPE esphome_fan_oscillation GAUGE\n";
 }
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::fan_row_(std::string &out, fan::Fan *obj, const std::string &labels) {
+  append_metric(out, "esphome_fan_failed", labels);
+  out += "} 0\n";
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  append_metric(out, "esphome_fan_value", labels);
+  out += "} ";
+  append_uint(out, obj->state);
+  out += '\n';
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->speed);
-    stream->print('\n');
+    append_metric(out, "esphome_fan_speed", labels);
+    out += "} ";
+    append_uint(out, obj->speed);
+    out += '\n';
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->oscillating);
-    stream->print('\n');
+    append_metric(out, "esphome_fan_oscillation", labels);
+    out += "} ";
+    append_uint(out, obj->oscillating);
+    out += '\n';
   }
 }
 #endif
 
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_light_state GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_color GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_effect_active GAUGE\n"));
+void PrometheusHandler::light_type_(std::string &out) {
+  out += "#TYPE esphome_light_state GAUGE\n"
+         "#TYPE esphome_light_color GAUGE\n"
+         "#TYPE esphome_light_effect_active GAUGE\n";
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::light_row_(std::string &out, light::LightState *obj, const std::string &labels) {
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->remote_values.is_on());
-  stream->print(F("\n"));
+  append_metric(out, "esphome_light_state", labels);
+  out += "} ";
+  append_uint(out, obj->remote_values.is_on());
+  out += '\n';
   // Brightness and RGBW
   light::LightColorValues color = obj->current_values;
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
-  stream->print(brightness);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"r\"} "));
-  stream->print(r);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"g\"} "));
-  stream->print(g);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"b\"} "));
-  stream->print(b);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"w\"} "));
-  stream->print(w);
-  stream->print(F("\n"));
+  append_metric(out, "esphome_light_color", labels);
+  out += ",channel=\"brightness\"} ";
+  append_value(out, brightness, 2);
+  out += '\n';
+  append_metric(out, "esphome_light_color", labels);
+  out += ",channel=\"r\"} ";
+  append_value(out, r, 2);
+  out += '\n';
+  append_metric(out, "esphome_light_color", labels);
+  out += ",channel=\"g\"} ";
+  append_value(out, g, 2);
+  out += '\n';
+  append_metric(out, "esphome_light_color", labels);
+  out += ",channel=\"b\"} ";
+  append_value(out, b, 2);
+  out += '\n';
+  append_metric(out, "esphome_light_color", labels);
+  out += ",channel=\"w\"} ";
+  append_value(out, w, 2);
+  out += '\n';
   // Effect
   std::string effect = obj->get_effect_name();
   if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
+    append_metric(out, "esphome_light_effect_active", labels);
+    out += ",effect=\"None\"} 0\n";
   } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
-    stream->print(F("\"} 1\n"));
+    append_metric(out, "esphome_light_effect_active", labels);
+    out += ",effect=\"";
+    out += effect;
+    out += "\"} 1\n";
   }
 }
 #endif
 
 #ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_cover_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_cover_failed GAUGE\n"));
+void PrometheusHandler::cover_type_(std::string &out) {
+  out += "#TYPE esphome_cover_value GAUGE\n"
+         "#TYPE esphome_cover_failed GAUGE\n";
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::cover_row_(std::string &out, cover::Cover *obj, const std::string &labels) {
   if (!std::isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    append_metric(out, "esphome_cover_failed", labels);
+    out += "} 0\n";
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->position);
-    stream->print('\n');
+    append_metric(out, "esphome_cover_value", labels);
+    out += "} ";
+    append_value(out, obj->position, 2);
+    out += '\n';
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(relabel_id_(obj).c_str());
-      stream->print(F("\",name=\""));
-      stream->print(relabel_name_(obj).c_str());
-      stream->print(F("\"} "));
-      stream->print(obj->tilt);
-      stream->print('\n');
+      append_metric(out, "esphome_cover_tilt", labels);
+      out += "} ";
+      append_value(out, obj->tilt, 2);
+      out += '\n';
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    append_metric(out, "esphome_cover_failed", labels);
+    out += "} 1\n";
   }
 }
 #endif
 
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_switch_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_switch_failed GAUGE\n"));
+void PrometheusHandler::switch_type_(std::string &out) {
+  out += "#TYPE esphome_switch_value GAUGE\n"
+         "#TYPE esphome_switch_failed GAUGE\n";
 }
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::switch_row_(std::string &out, switch_::Switch *obj, const std::string &labels) {
+  append_metric(out, "esphome_switch_failed", labels);
+  out += "} 0\n";
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  append_metric(out, "esphome_switch_value", labels);
+  out += "} ";
+  append_uint(out, obj->state);
+  out += '\n';
 }
 #endif
 
 #ifdef USE_LOCK
-void PrometheusHandler::lock_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_lock_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_lock_failed GAUGE\n"));
+void PrometheusHandler::lock_type_(std::string &out) {
+  out += "#TYPE esphome_lock_value GAUGE\n"
+         "#TYPE esphome_lock_failed GAUGE\n";
 }
-void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_lock_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::lock_row_(std::string &out, lock::Lock *obj, const std::string &labels) {
+  append_metric(out, "esphome_lock_failed", labels);
+  out += "} 0\n";
   // Data itself
-  stream->print(F("esphome_lock_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  append_metric(out, "esphome_lock_value", labels);
+  out += "} ";
+  append_uint(out, obj->state);
+  out += '\n';
 }
 #endif
 
@@ -13,7 +13,8 @@ void PulseMeterSensor::setup() {
 
   this->last_detected_edge_us_ = 0;
   this->last_valid_edge_us_ = 0;
-  this->pulse_width_us_ = 0;
+  this->pulse_width_head_ = 0;
+  this->pulse_width_tail_ = 0;
   this->sensor_is_high_ = this->isr_pin_.digital_read();
   this->has_valid_edge_ = false;
   this->pending_state_change_ = NONE;
@@ -39,25 +40,42 @@ void PulseMeterSensor::loop() {
   // If we've exceeded our timeout interval without receiving any pulses, assume 0 pulses/min until
   // we get at least two valid pulses.
   const uint32_t time_since_valid_edge_us = now - last_detected_edge_us;
+  bool timed_out = false;
   if ((has_valid_edge) && (time_since_valid_edge_us > this->timeout_us_)) {
     ESP_LOGD(TAG, "No pulse detected for %us, assuming 0 pulses/min", time_since_valid_edge_us / 1000000);
 
     this->last_valid_edge_us_ = 0;
-    this->pulse_width_us_ = 0;
     this->has_valid_edge_ = false;
     this->last_detected_edge_us_ = 0;
+    timed_out = true;
   }
 
-  // We quantize our pulse widths to 1 ms to avoid unnecessary jitter
-  const uint32_t pulse_width_ms = this->pulse_width_us_ / 1000;
-  if (this->pulse_width_dedupe_.next(pulse_width_ms)) {
-    if (pulse_width_ms == 0) {
-      // Treat 0 pulse width as 0 pulses/min (normally because we've not detected any pulses for a while)
-      this->publish_state(0);
-    } else {
-      // Calculate pulses/min from the pulse width in ms
-      this->publish_state((60.0f * 1000.0f) / pulse_width_ms);
-    }
+  // Publish every pulse measured since the last iteration as one batch, so filters see all of them
+  const uint8_t head = this->pulse_width_head_;
+  const uint32_t last_edge_us = this->last_valid_edge_us_;
+  if ((uint8_t) (head - this->pulse_width_tail_) > PULSE_WIDTH_BUFFER_SIZE) {
+    // the oldest pulses were overwritten
+    this->pulse_width_tail_ = head - PULSE_WIDTH_BUFFER_SIZE;
+  }
+  float rates[PULSE_WIDTH_BUFFER_SIZE];
+  size_t count = 0;
+  bool changed = false;
+  for (; this->pulse_width_tail_ != head; this->pulse_width_tail_++) {
+    // We quantize our pulse widths to 1 ms to avoid unnecessary jitter
+    const uint32_t pulse_width_ms = this->pulse_widths_us_[this->pulse_width_tail_ % PULSE_WIDTH_BUFFER_SIZE] / 1000;
+    changed |= this->pulse_width_dedupe_.next(pulse_width_ms);
+    // Calculate pulses/min from the pulse width in ms
+    rates[count++] = pulse_width_ms == 0 ? 0.0f : (60.0f * 1000.0f) / pulse_width_ms;
+  }
+  if (changed) {
+    // The last pulse ended at the last valid edge, which can be a whole loop() interval ago
+    const uint32_t captured_ms = millis() - (micros() - last_edge_us) / 1000;
+    this->publish_batch(rates, count, captured_ms);
+  }
+
+  if (timed_out && this->pulse_width_dedupe_.next(0)) {
+    // Treat 0 pulse width as 0 pulses/min (we've not detected any pulses for a while)
+    this->publish_state(0);
   }
 
   if (this->total_sensor_ != nullptr) {
@@ -81,6 +99,11 @@ void PulseMeterSensor::dump_config() {
   ESP_LOGCONFIG(TAG, "  Assuming 0 pulses/min after not receiving a pulse for %us", this->timeout_us_ / 1000000);
 }
 
+void IRAM_ATTR PulseMeterSensor::record_pulse_width_(uint32_t pulse_width_us) {
+  this->pulse_widths_us_[this->pulse_width_head_ % PULSE_WIDTH_BUFFER_SIZE] = pulse_width_us;
+  this->pulse_width_head_ = this->pulse_width_head_ + 1;
+}
+
 void IRAM_ATTR PulseMeterSensor::gpio_intr(PulseMeterSensor *sensor) {
   // This is an interrupt handler - we can't call any virtual method from this method
   // Get the current time before we do anything else so the measurements are consistent
@@ -96,7 +119,7 @@ void IRAM_ATTR PulseMeterSensor::gpio_intr(PulseMeterSensor *sensor) {
     if ((now - sensor->last_detected_edge_us_) >= sensor->filter_us_) {
       // Don't measure the first valid pulse (we need at least two pulses to measure the width)
       if (sensor->has_valid_edge_) {
-        sensor->pulse_width_us_ = (now - sensor->last_valid_edge_us_);
+        sensor->record_pulse_width_(now - sensor->last_valid_edge_us_);
       }
       sensor->total_pulses_++;
       sensor->last_valid_edge_us_ = now;
@@ -120,7 +143,7 @@ void IRAM_ATTR PulseMeterSensor::gpio_intr(PulseMeterSensor *sensor) {
         // We need to handle a pulse that would have been missed by the loop function
         sensor->total_pulses_++;
         if (sensor->has_valid_edge_) {
-          sensor->pulse_width_us_ = sensor->last_detected_edge_us_ - sensor->last_valid_edge_us_;
+          sensor->record_pulse_width_(sensor->last_detected_edge_us_ - sensor->last_valid_edge_us_);
           sensor->has_valid_edge_ = true;
           sensor->last_valid_edge_us_ = sensor->last_detected_edge_us_;
         }
@@ -163,8 +186,12 @@ void PulseMeterSensor::handle_state_change_(uint32_t now, uint32_t last_detected
       ESP_LOGVV(TAG, "Incremented pulses to %u", this->total_pulses_);
 
       if (has_valid_edge) {
-        this->pulse_width_us_ = last_detected_edge_us - last_valid_edge_us;
-        ESP_LOGVV(TAG, "Set pulse width to %u", this->pulse_width_us_);
+        {
+          // the ISR records pulse widths as well
+          InterruptLock lock;
+          this->record_pulse_width_(last_detected_edge_us - last_valid_edge_us);
+        }
+        ESP_LOGVV(TAG, "Set pulse width to %u", last_detected_edge_us - last_valid_edge_us);
       }
       this->has_valid_edge_ = true;
       this->last_valid_edge_us_ = last_detected_edge_us;
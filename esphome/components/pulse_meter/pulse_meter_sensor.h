@@ -31,7 +31,12 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
  protected:
   enum StateChange { TO_LOW = 0, TO_HIGH, NONE };
 
+  /// Number of pulse widths buffered between two loop() iterations, more pulses overwrite the oldest ones.
+  static const uint8_t PULSE_WIDTH_BUFFER_SIZE = 16;
+
   static void gpio_intr(PulseMeterSensor *sensor);
+  /// Queue a measured pulse width for the next loop(), must not race with the ISR.
+  void record_pulse_width_(uint32_t pulse_width_us);
   void handle_state_change_(uint32_t now, uint32_t last_detected_edge_us, uint32_t last_valid_edge_us,
                             bool has_valid_edge);
 
@@ -47,7 +52,9 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
 
   volatile uint32_t last_detected_edge_us_ = 0;
   volatile uint32_t last_valid_edge_us_ = 0;
-  volatile uint32_t pulse_width_us_ = 0;
+  volatile uint32_t pulse_widths_us_[PULSE_WIDTH_BUFFER_SIZE] = {};
+  volatile uint8_t pulse_width_head_ = 0;
+  uint8_t pulse_width_tail_ = 0;
   volatile uint32_t total_pulses_ = 0;
   volatile bool sensor_is_high_ = false;
   volatile bool has_valid_edge_ = false;
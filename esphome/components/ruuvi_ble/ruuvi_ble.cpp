@@ -8,12 +8,14 @@ namespace ruuvi_ble {
 
 static const char *const TAG = "ruuvi_ble";
 
-bool parse_ruuvi_data_byte(const esp32_ble_tracker::adv_data_t &adv_data, RuuviParseResult &result) {
+bool parse_ruuvi_data_byte(const uint8_t *adv_data, uint8_t adv_data_size, RuuviParseResult &result) {
+  if (adv_data_size < 1)
+    return false;
   const uint8_t data_type = adv_data[0];
   const auto *data = &adv_data[1];
   switch (data_type) {
     case 0x03: {  // RAWv1
-      if (adv_data.size() != 14)
+      if (adv_data_size != 14)
         return false;
 
       const uint8_t temp_sign = (data[1] >> 7) & 1;
@@ -40,7 +42,7 @@ bool parse_ruuvi_data_byte(const esp32_ble_tracker::adv_data_t &adv_data, RuuviP
       return true;
     }
     case 0x05: {  // RAWv2
-      if (adv_data.size() != 24)
+      if (adv_data_size != 24)
         return false;
 
       const float temperature = (int16_t(data[0] << 8) + int16_t(data[1])) * 0.005f;
@@ -81,12 +83,13 @@ bool parse_ruuvi_data_byte(const esp32_ble_tracker::adv_data_t &adv_data, RuuviP
 optional<RuuviParseResult> parse_ruuvi(const esp32_ble_tracker::ESPBTDevice &device) {
   bool success = false;
   RuuviParseResult result{};
-  for (auto &it : device.get_manufacturer_datas()) {
-    bool is_ruuvi = it.uuid.contains(0x99, 0x04);
+  for (const auto &record : device.get_adv_records()) {
+    auto it = record.get_manufacturer_data();
+    bool is_ruuvi = it.has_value() && it->uuid.contains(0x99, 0x04);
     if (!is_ruuvi)
       continue;
 
-    if (parse_ruuvi_data_byte(it.data, result))
+    if (parse_ruuvi_data_byte(it->data, it->size, result))
       success = true;
   }
   if (!success)
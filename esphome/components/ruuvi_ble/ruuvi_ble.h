@@ -22,7 +22,7 @@ struct RuuviParseResult {
   optional<float> measurement_sequence_number;
 };
 
-bool parse_ruuvi_data_byte(uint8_t data_type, const uint8_t *data, uint8_t data_length, RuuviParseResult &result);
+bool parse_ruuvi_data_byte(const uint8_t *adv_data, uint8_t adv_data_size, RuuviParseResult &result);
 
 optional<RuuviParseResult> parse_ruuvi(const esp32_ble_tracker::ESPBTDevice &device);
 
@@ -14,6 +14,8 @@ class RuuviTag : public Component, public esp32_ble_tracker::ESPBTDeviceListener
  public:
   void set_address(uint64_t address) { address_ = address; }
 
+  std::vector<uint64_t> get_address_filter() const override { return {this->address_}; }
+
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override {
     if (device.address_uint64() != this->address_)
       return false;
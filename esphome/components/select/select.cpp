@@ -19,7 +19,7 @@ void Select::publish_state(const std::string &state) {
   }
 }
 
-void Select::add_on_state_callback(std::function<void(std::string, size_t)> &&callback) {
+void Select::add_on_state_callback(std::function<void(const std::string &, size_t)> &&callback) {
   this->state_callback_.add(std::move(callback));
 }
 
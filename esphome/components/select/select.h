@@ -59,7 +59,7 @@ class Select : public EntityBase {
   /// Return the (optional) option value at the provided index offset.
   optional<std::string> at(size_t index) const;
 
-  void add_on_state_callback(std::function<void(std::string, size_t)> &&callback);
+  void add_on_state_callback(std::function<void(const std::string &, size_t)> &&callback);
 
  protected:
   friend class SelectCall;
@@ -72,7 +72,7 @@ class Select : public EntityBase {
    */
   virtual void control(const std::string &value) = 0;
 
-  CallbackManager<void(std::string, size_t)> state_callback_;
+  CallbackManager<void(const std::string &, size_t)> state_callback_;
   bool has_state_{false};
 };
 
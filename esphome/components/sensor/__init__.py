@@ -26,6 +26,7 @@ from esphome.const import (
     CONF_TO,
     CONF_TRIGGER_ID,
     CONF_TYPE,
+    CONF_TYPE_ID,
     CONF_UNIT_OF_MEASUREMENT,
     CONF_WINDOW_SIZE,
     CONF_MQTT_ID,
@@ -223,6 +224,10 @@ DeltaFilter = sensor_ns.class_("DeltaFilter", Filter)
 OrFilter = sensor_ns.class_("OrFilter", Filter)
 CalibrateLinearFilter = sensor_ns.class_("CalibrateLinearFilter", Filter)
 CalibratePolynomialFilter = sensor_ns.class_("CalibratePolynomialFilter", Filter)
+FusedFilter = sensor_ns.class_("FusedFilter", Filter)
+AffineFilterStage = sensor_ns.class_("AffineFilterStage")
+DeltaFilterStage = sensor_ns.class_("DeltaFilterStage")
+ThrottleFilterStage = sensor_ns.class_("ThrottleFilterStage")
 SensorInRangeCondition = sensor_ns.class_("SensorInRangeCondition", Filter)
 
 validate_unit_of_measurement = cv.string_strict
@@ -319,7 +324,7 @@ async def filter_out_filter_to_code(config, filter_id):
 QUANTILE_SCHEMA = cv.All(
     cv.Schema(
         {
-            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.positive_not_null_int,
+            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.int_range(min=1, max=65535),
             cv.Optional(CONF_SEND_EVERY, default=5): cv.positive_not_null_int,
             cv.Optional(CONF_SEND_FIRST_AT, default=1): cv.positive_not_null_int,
             cv.Optional(CONF_QUANTILE, default=0.9): cv.zero_to_one_float,
@@ -343,7 +348,7 @@ async def quantile_filter_to_code(config, filter_id):
 MEDIAN_SCHEMA = cv.All(
     cv.Schema(
         {
-            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.positive_not_null_int,
+            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.int_range(min=1, max=65535),
             cv.Optional(CONF_SEND_EVERY, default=5): cv.positive_not_null_int,
             cv.Optional(CONF_SEND_FIRST_AT, default=1): cv.positive_not_null_int,
         }
@@ -607,8 +612,76 @@ async def calibrate_polynomial_filter_to_code(config, filter_id):
     return cg.new_Pvariable(filter_id, res)
 
 
+# Filters that can be fused into a single FusedFilter when they follow each other,
+# the affine ones are folded into one AffineFilterStage.
+AFFINE_FILTERS = ["offset", "multiply", "calibrate_linear"]
+FUSIBLE_FILTERS = AFFINE_FILTERS + ["delta", "throttle"]
+
+
+def _filter_key(conf):
+    return next(k for k in conf if k in FILTER_REGISTRY)
+
+
+def _affine_coefficients(key, config):
+    if key == "offset":
+        return 1.0, config
+    if key == "multiply":
+        return config, 0.0
+    x = [conf[CONF_FROM] for conf in config]
+    y = [conf[CONF_TO] for conf in config]
+    return fit_linear(x, y)
+
+
+def _fused_filter_stages(run):
+    stages = []
+    affine = None
+    for conf in run:
+        key = _filter_key(conf)
+        config = conf[key]
+        if key in AFFINE_FILTERS:
+            k, b = _affine_coefficients(key, config)
+            affine = (k, b) if affine is None else (k * affine[0], k * affine[1] + b)
+            continue
+        if affine is not None:
+            stages.append((AffineFilterStage, affine))
+            affine = None
+        if key == "delta":
+            percentage = config[CONF_TYPE] == "percentage"
+            stages.append((DeltaFilterStage, (config[CONF_VALUE], percentage)))
+        else:
+            stages.append((ThrottleFilterStage, (config,)))
+    if affine is not None:
+        stages.append((AffineFilterStage, affine))
+    return stages
+
+
+def _build_fused_filter(run):
+    stages = _fused_filter_stages(run)
+    fused_id = run[0][CONF_TYPE_ID].copy()
+    fused_id.type = FusedFilter
+    template_args = cg.TemplateArguments(*[stage for stage, _ in stages])
+    return cg.new_Pvariable(
+        fused_id, template_args, *[stage(*args) for stage, args in stages]
+    )
+
+
 async def build_filters(config):
-    return await cg.build_registry_list(FILTER_REGISTRY, config)
+    # Runs of more than one fusible filter become a single statically typed filter,
+    # everything else is built as its own filter object.
+    filters = []
+    run = []
+    for conf in list(config) + [None]:
+        if conf is not None and _filter_key(conf) in FUSIBLE_FILTERS:
+            run.append(conf)
+            continue
+        if len(run) > 1:
+            filters.append(_build_fused_filter(run))
+        elif run:
+            filters.append(await cg.build_registry_entry(FILTER_REGISTRY, run[0]))
+        run = []
+        if conf is not None:
+            filters.append(await cg.build_registry_entry(FILTER_REGISTRY, conf))
+    return filters
 
 
 async def setup_sensor_core_(var, config):
@@ -9,20 +9,61 @@ namespace sensor {
 
 static const char *const TAG = "sensor.filter";
 
+// Number of values a filter processes at once in the batch path
+static const size_t FILTER_BATCH_SIZE = 32;
+
 // Filter
-void Filter::input(float value) {
+void Filter::input(float value, uint32_t timestamp) {
   ESP_LOGVV(TAG, "Filter(%p)::input(%f)", this, value);
+  this->input_timestamp_ = timestamp;
   optional<float> out = this->new_value(value);
   if (out.has_value())
-    this->output(*out);
+    this->output(*out, timestamp);
 }
-void Filter::output(float value) {
+void Filter::output(float value) { this->output(value, millis()); }
+void Filter::output(float value, uint32_t timestamp) {
+  if (this->parent_->batching_) {
+    // filters that emit from new_value(), like the or filter, keep the rest of the chain on the batch path
+    this->output_batch(&value, 1, timestamp);
+    return;
+  }
   if (this->next_ == nullptr) {
     ESP_LOGVV(TAG, "Filter(%p)::output(%f) -> SENSOR", this, value);
-    this->parent_->internal_send_state_to_frontend(value);
+    this->parent_->internal_send_state_to_frontend(value, timestamp);
   } else {
     ESP_LOGVV(TAG, "Filter(%p)::output(%f) -> %p", this, value, this->next_);
-    this->next_->input(value);
+    this->next_->input(value, timestamp);
+  }
+}
+size_t Filter::new_values(const float *values, size_t count, float *out) {
+  size_t out_count = 0;
+  for (size_t i = 0; i < count; i++) {
+    optional<float> value = this->new_value(values[i]);
+    if (value.has_value())
+      out[out_count++] = *value;
+  }
+  return out_count;
+}
+void Filter::input_batch(const float *values, size_t count, uint32_t timestamp) {
+  ESP_LOGVV(TAG, "Filter(%p)::input_batch(%zu values)", this, count);
+  float out[FILTER_BATCH_SIZE];
+  while (count > 0) {
+    size_t chunk = std::min(count, FILTER_BATCH_SIZE);
+    this->input_timestamp_ = timestamp;
+    this->output_batch(out, this->new_values(values, chunk, out), timestamp);
+    values += chunk;
+    count -= chunk;
+  }
+}
+void Filter::output_batch(const float *values, size_t count, uint32_t timestamp) {
+  if (count == 0)
+    return;
+  if (this->next_ == nullptr) {
+    ESP_LOGVV(TAG, "Filter(%p)::output_batch(%zu values) -> SENSOR", this, count);
+    this->parent_->batch_output_(values[count - 1], timestamp);
+  } else {
+    ESP_LOGVV(TAG, "Filter(%p)::output_batch(%zu values) -> %p", this, count, this->next_);
+    this->next_->input_batch(values, count, timestamp);
   }
 }
 void Filter::initialize(Sensor *parent, Filter *next) {
@@ -31,40 +72,168 @@ void Filter::initialize(Sensor *parent, Filter *next) {
   this->next_ = next;
 }
 
+// DeltaFilterStage
+bool DeltaFilterStage::apply(float &value) {
+  if (std::isnan(value)) {
+    if (std::isnan(this->last_value_)) {
+      return false;
+    } else {
+      if (this->percentage_mode_) {
+        this->current_delta_ = fabsf(value * this->delta_);
+      }
+      this->last_value_ = value;
+      return true;
+    }
+  }
+  if (std::isnan(this->last_value_) || fabsf(value - this->last_value_) >= this->current_delta_) {
+    if (this->percentage_mode_) {
+      this->current_delta_ = fabsf(value * this->delta_);
+    }
+    this->last_value_ = value;
+    return true;
+  }
+  return false;
+}
+
+// ThrottleFilterStage
+bool ThrottleFilterStage::apply(float &value) {
+  const uint32_t now = millis();
+  if (this->last_input_ == 0 || now - this->last_input_ >= this->min_time_between_inputs_) {
+    this->last_input_ = now;
+    return true;
+  }
+  return false;
+}
+
+// SortedWindow
+SortedWindow::SortedWindow(size_t capacity) { this->set_capacity(capacity); }
+void SortedWindow::set_capacity(size_t capacity) {
+  if (capacity > MAX_CAPACITY)
+    capacity = MAX_CAPACITY;
+  this->values_.assign(capacity, NAN);
+  this->heap_of_.assign(capacity, HEAP_NONE);
+  this->heap_pos_.assign(capacity, 0);
+  this->lower_.clear();
+  this->lower_.reserve(capacity);
+  this->upper_.clear();
+  this->upper_.reserve(capacity);
+  this->head_ = 0;
+  this->size_ = 0;
+}
+void SortedWindow::push(float value) {
+  if (this->values_.empty())
+    return;
+  uint16_t slot;
+  if (this->size_ == this->values_.size()) {
+    slot = this->head_;
+    this->head_ = (this->head_ + 1) % this->values_.size();
+    this->heap_erase_(slot);
+  } else {
+    slot = (this->head_ + this->size_) % this->values_.size();
+    this->size_++;
+  }
+  this->values_[slot] = value;
+  if (std::isnan(value))
+    return;
+  // keep every value of the lower heap less than or equal to every value of the upper heap
+  if (!this->lower_.empty() && value <= this->lower_max()) {
+    this->heap_push_(HEAP_LOWER, slot);
+  } else {
+    this->heap_push_(HEAP_UPPER, slot);
+  }
+}
+void SortedWindow::partition(size_t lower_count) {
+  while (this->lower_.size() > lower_count) {
+    uint16_t slot = this->lower_.front();
+    this->heap_erase_(slot);
+    this->heap_push_(HEAP_UPPER, slot);
+  }
+  while (this->lower_.size() < lower_count && !this->upper_.empty()) {
+    uint16_t slot = this->upper_.front();
+    this->heap_erase_(slot);
+    this->heap_push_(HEAP_LOWER, slot);
+  }
+}
+bool SortedWindow::above_(HeapId heap, uint16_t a, uint16_t b) const {
+  return heap == HEAP_LOWER ? this->values_[a] > this->values_[b] : this->values_[a] < this->values_[b];
+}
+void SortedWindow::set_(HeapId heap, uint16_t pos, uint16_t slot) {
+  this->heap_(heap)[pos] = slot;
+  this->heap_pos_[slot] = pos;
+}
+void SortedWindow::sift_up_(HeapId heap, uint16_t pos) {
+  auto &h = this->heap_(heap);
+  uint16_t slot = h[pos];
+  while (pos > 0) {
+    uint16_t parent = (pos - 1) / 2;
+    if (!this->above_(heap, slot, h[parent]))
+      break;
+    this->set_(heap, pos, h[parent]);
+    pos = parent;
+  }
+  this->set_(heap, pos, slot);
+}
+void SortedWindow::sift_down_(HeapId heap, uint16_t pos) {
+  auto &h = this->heap_(heap);
+  uint16_t slot = h[pos];
+  while (true) {
+    // the child of a position in the upper half doesn't fit 16 bits
+    size_t child = size_t(pos) * 2 + 1;
+    if (child >= h.size())
+      break;
+    if (child + 1 < h.size() && this->above_(heap, h[child + 1], h[child]))
+      child++;
+    if (!this->above_(heap, h[child], slot))
+      break;
+    this->set_(heap, pos, h[child]);
+    pos = child;
+  }
+  this->set_(heap, pos, slot);
+}
+void SortedWindow::heap_push_(HeapId heap, uint16_t slot) {
+  auto &h = this->heap_(heap);
+  this->heap_of_[slot] = heap;
+  h.push_back(slot);
+  this->sift_up_(heap, h.size() - 1);
+}
+void SortedWindow::heap_erase_(uint16_t slot) {
+  auto heap = static_cast<HeapId>(this->heap_of_[slot]);
+  if (heap == HEAP_NONE)
+    return;
+  this->heap_of_[slot] = HEAP_NONE;
+  auto &h = this->heap_(heap);
+  uint16_t pos = this->heap_pos_[slot];
+  uint16_t last = h.back();
+  h.pop_back();
+  if (last == slot)
+    return;
+  // move the last element into the hole and restore the heap property in whichever direction is needed
+  this->set_(heap, pos, last);
+  this->sift_up_(heap, pos);
+  this->sift_down_(heap, this->heap_pos_[last]);
+}
+
 // MedianFilter
 MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MedianFilter::set_window_size(size_t window_size) { this->window_.set_capacity(window_size); }
 optional<float> MedianFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float median = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> median_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          median_queue.push_back(v);
-        }
-      }
-
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size) {
-        if (queue_size % 2) {
-          median = median_queue[queue_size / 2];
-        } else {
-          median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-        }
+    size_t queue_size = this->window_.count();
+    if (queue_size) {
+      if (queue_size % 2) {
+        this->window_.partition(queue_size / 2 + 1);
+        median = this->window_.lower_max();
+      } else {
+        this->window_.partition(queue_size / 2);
+        median = (this->window_.upper_min() + this->window_.lower_max()) / 2.0f;
       }
     }
 
@@ -89,38 +258,24 @@ optional<float> SkipInitialFilter::new_value(float value) {
 
 // QuantileFilter
 QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at), quantile_(quantile) {}
 void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void QuantileFilter::set_window_size(size_t window_size) { this->window_.set_capacity(window_size); }
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
 optional<float> QuantileFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float result = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> quantile_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          quantile_queue.push_back(v);
-        }
-      }
-
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
-      if (queue_size) {
-        size_t position = ceilf(queue_size * this->quantile_) - 1;
-        ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
-        result = quantile_queue[position];
-      }
+    size_t queue_size = this->window_.count();
+    if (queue_size) {
+      size_t position = std::max(ceilf(queue_size * this->quantile_), 1.0f) - 1;
+      ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
+      this->window_.partition(position + 1);
+      result = this->window_.lower_max();
     }
 
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING %f", this, value, result);
@@ -129,27 +284,53 @@ optional<float> QuantileFilter::new_value(float value) {
   return {};
 }
 
+// MonotonicWindow
+MonotonicWindow::MonotonicWindow(size_t capacity, bool maximum) : maximum_(maximum) { this->set_capacity(capacity); }
+void MonotonicWindow::set_capacity(size_t capacity) {
+  this->queue_.assign(capacity, Entry{0, NAN});
+  this->head_ = 0;
+  this->size_ = 0;
+  this->written_ = 0;
+}
+void MonotonicWindow::push(float value) {
+  if (this->queue_.empty())
+    return;
+  uint32_t seq = this->written_++;
+  // the queue is ordered by age, so only the front can have left the window
+  if (this->size_ && seq - this->at_(0).seq >= this->queue_.size()) {
+    this->head_ = (this->head_ + 1) % this->queue_.size();
+    this->size_--;
+  }
+  if (std::isnan(value))
+    return;
+  // values that are not better than the new one can never become the extremum again
+  while (this->size_) {
+    float back = this->at_(this->size_ - 1).value;
+    if (this->maximum_ ? back > value : back < value)
+      break;
+    this->size_--;
+  }
+  this->at_(this->size_++) = Entry{seq, value};
+}
+float MonotonicWindow::get() const {
+  if (!this->size_)
+    return NAN;
+  return this->queue_[this->head_].value;
+}
+
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size, false), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MinFilter::set_window_size(size_t window_size) { this->window_.set_capacity(window_size); }
 optional<float> MinFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float min = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        min = std::isnan(min) ? v : std::min(min, v);
-      }
-    }
+    float min = this->window_.get();
 
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING %f", this, value, min);
     return min;
@@ -157,27 +338,31 @@ optional<float> MinFilter::new_value(float value) {
   return {};
 }
 
+size_t MinFilter::new_values(const float *values, size_t count, float *out) {
+  size_t out_count = 0;
+  for (size_t i = 0; i < count; i++) {
+    this->window_.push(values[i]);
+    if (++this->send_at_ >= this->send_every_) {
+      this->send_at_ = 0;
+      out[out_count++] = this->window_.get();
+    }
+  }
+  return out_count;
+}
+
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size, true), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MaxFilter::set_window_size(size_t window_size) { this->window_.set_capacity(window_size); }
 optional<float> MaxFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float max = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        max = std::isnan(max) ? v : std::max(max, v);
-      }
-    }
+    float max = this->window_.get();
 
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING %f", this, value, max);
     return max;
@@ -185,41 +370,98 @@ optional<float> MaxFilter::new_value(float value) {
   return {};
 }
 
+size_t MaxFilter::new_values(const float *values, size_t count, float *out) {
+  size_t out_count = 0;
+  for (size_t i = 0; i < count; i++) {
+    this->window_.push(values[i]);
+    if (++this->send_at_ >= this->send_every_) {
+      this->send_at_ = 0;
+      out[out_count++] = this->window_.get();
+    }
+  }
+  return out_count;
+}
+
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : values_(window_size, NAN), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
+void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) {
+  this->values_.assign(window_size, NAN);
+  this->head_ = 0;
+  this->size_ = 0;
+  this->nan_count_ = 0;
+  this->sum_ = 0.0f;
+  this->compensation_ = 0.0f;
+}
+void SlidingWindowMovingAverageFilter::add_(float value) {
+  // Kahan summation, keeps the running sum from drifting as values are added and removed
+  float y = value - this->compensation_;
+  float t = this->sum_ + y;
+  this->compensation_ = (t - this->sum_) - y;
+  this->sum_ = t;
+}
+void SlidingWindowMovingAverageFilter::push_(float value) {
+  if (this->values_.empty())
+    return;
+  size_t slot;
+  if (this->size_ == this->values_.size()) {
+    slot = this->head_;
+    this->head_ = (this->head_ + 1) % this->values_.size();
+    float old = this->values_[slot];
+    if (std::isnan(old)) {
+      this->nan_count_--;
+    } else {
+      this->add_(-old);
+    }
+  } else {
+    slot = (this->head_ + this->size_) % this->values_.size();
+    this->size_++;
   }
-  this->queue_.push_back(value);
+  this->values_[slot] = value;
+  if (std::isnan(value)) {
+    this->nan_count_++;
+  } else {
+    this->add_(value);
+  }
+  if (this->size_ == this->nan_count_) {
+    // nothing left to average, drop any accumulated rounding error
+    this->sum_ = 0.0f;
+    this->compensation_ = 0.0f;
+  }
+}
+float SlidingWindowMovingAverageFilter::average_() const {
+  size_t valid_count = this->size_ - this->nan_count_;
+  if (!valid_count)
+    return NAN;
+  return this->sum_ / valid_count;
+}
+optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
+  this->push_(value);
   ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float sum = 0;
-    size_t valid_count = 0;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        sum += v;
-        valid_count++;
-      }
-    }
-
-    float average = NAN;
-    if (valid_count) {
-      average = sum / valid_count;
-    }
+    float average = this->average_();
 
     ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f) SENDING %f", this, value, average);
     return average;
   }
   return {};
 }
+size_t SlidingWindowMovingAverageFilter::new_values(const float *values, size_t count, float *out) {
+  size_t out_count = 0;
+  for (size_t i = 0; i < count; i++) {
+    this->push_(values[i]);
+    if (++this->send_at_ >= this->send_every_) {
+      this->send_at_ = 0;
+      out[out_count++] = this->average_();
+    }
+  }
+  return out_count;
+}
 
 // ExponentialMovingAverageFilter
 ExponentialMovingAverageFilter::ExponentialMovingAverageFilter(float alpha, size_t send_every, size_t send_first_at)
@@ -317,37 +559,19 @@ optional<float> FilterOutValueFilter::new_value(float value) {
 }
 
 // ThrottleFilter
-ThrottleFilter::ThrottleFilter(uint32_t min_time_between_inputs) : min_time_between_inputs_(min_time_between_inputs) {}
+ThrottleFilter::ThrottleFilter(uint32_t min_time_between_inputs) : stage_(min_time_between_inputs) {}
 optional<float> ThrottleFilter::new_value(float value) {
-  const uint32_t now = millis();
-  if (this->last_input_ == 0 || now - this->last_input_ >= min_time_between_inputs_) {
-    this->last_input_ = now;
-    return value;
-  }
-  return {};
+  if (!this->stage_.apply(value))
+    return {};
+  return value;
 }
 
 // DeltaFilter
-DeltaFilter::DeltaFilter(float delta, bool percentage_mode)
-    : delta_(delta), current_delta_(delta), percentage_mode_(percentage_mode), last_value_(NAN) {}
+DeltaFilter::DeltaFilter(float delta, bool percentage_mode) : stage_(delta, percentage_mode) {}
 optional<float> DeltaFilter::new_value(float value) {
-  if (std::isnan(value)) {
-    if (std::isnan(this->last_value_)) {
-      return {};
-    } else {
-      if (this->percentage_mode_) {
-        this->current_delta_ = fabsf(value * this->delta_);
-      }
-      return this->last_value_ = value;
-    }
-  }
-  if (std::isnan(this->last_value_) || fabsf(value - this->last_value_) >= this->current_delta_) {
-    if (this->percentage_mode_) {
-      this->current_delta_ = fabsf(value * this->delta_);
-    }
-    return this->last_value_ = value;
-  }
-  return {};
+  if (!this->stage_.apply(value))
+    return {};
+  return value;
 }
 
 // OrFilter
@@ -355,13 +579,13 @@ OrFilter::OrFilter(std::vector<Filter *> filters) : filters_(std::move(filters))
 OrFilter::PhiNode::PhiNode(OrFilter *or_parent) : or_parent_(or_parent) {}
 
 optional<float> OrFilter::PhiNode::new_value(float value) {
-  this->or_parent_->output(value);
+  this->or_parent_->output(value, this->input_timestamp_);
 
   return {};
 }
 optional<float> OrFilter::new_value(float value) {
   for (Filter *filter : this->filters_)
-    filter->input(value);
+    filter->input(value, this->input_timestamp_);
 
   return {};
 }
@@ -29,20 +29,215 @@ class Filter {
    */
   virtual optional<float> new_value(float value) = 0;
 
+  /** Process a block of values, used by Sensor::publish_batch().
+   *
+   * The default implementation calls new_value() for each value, filters that can consume a block in one go
+   * override this.
+   *
+   * @param values The new values.
+   * @param count The number of values.
+   * @param out Receives the values that should be pushed out, has room for at least count values.
+   * @return The number of values written to out.
+   */
+  virtual size_t new_values(const float *values, size_t count, float *out);
+
   /// Initialize this filter, please note this can be called more than once.
   virtual void initialize(Sensor *parent, Filter *next);
 
-  void input(float value);
+  /// Pass a value that was captured at timestamp (in millis()) through this filter.
+  void input(float value, uint32_t timestamp);
 
+  /// Send a value down the chain, stamped with the current time. For filters that send values later, from a timer.
   void output(float value);
+  /// Send a value down the chain that belongs to the sample captured at timestamp.
+  void output(float value, uint32_t timestamp);
+
+  void input_batch(const float *values, size_t count, uint32_t timestamp);
+
+  void output_batch(const float *values, size_t count, uint32_t timestamp);
 
  protected:
   friend Sensor;
 
+  /// Capture time of the value(s) new_value() or new_values() is processing.
+  uint32_t input_timestamp_{0};
+
   Filter *next_{nullptr};
   Sensor *parent_{nullptr};
 };
 
+/** Filter stages are the building blocks of a FusedFilter.
+ *
+ * A stage is a plain class with a non-virtual `bool apply(float &value)` that transforms the value in place and
+ * returns false to stop the chain. They don't know about the sensor or the next filter, so a chain of them can be
+ * inlined into a single Filter.
+ */
+
+/// Stage that maps each value to `slope * value + bias`, consecutive offset, multiply and calibrate_linear filters
+/// are folded into one of these.
+class AffineFilterStage {
+ public:
+  AffineFilterStage(float slope, float bias) : slope_(slope), bias_(bias) {}
+  bool apply(float &value) {
+    value = value * this->slope_ + this->bias_;
+    return true;
+  }
+
+ protected:
+  float slope_;
+  float bias_;
+};
+
+/// Stage that only passes values that differ enough from the last passed value, see DeltaFilter.
+class DeltaFilterStage {
+ public:
+  DeltaFilterStage(float delta, bool percentage_mode)
+      : delta_(delta), current_delta_(delta), percentage_mode_(percentage_mode) {}
+  bool apply(float &value);
+
+ protected:
+  float delta_;
+  float current_delta_;
+  bool percentage_mode_;
+  float last_value_{NAN};
+};
+
+/// Stage that only passes a value if enough time has passed since the last passed value, see ThrottleFilter.
+class ThrottleFilterStage {
+ public:
+  explicit ThrottleFilterStage(uint32_t min_time_between_inputs)
+      : min_time_between_inputs_(min_time_between_inputs) {}
+  bool apply(float &value);
+
+ protected:
+  uint32_t last_input_{0};
+  uint32_t min_time_between_inputs_;
+};
+
+/// Statically typed chain of filter stages, each stage is applied in order until one of them stops the chain.
+template<typename... Stages> class FilterPipeline;
+
+template<> class FilterPipeline<> {
+ public:
+  bool apply(float &) { return true; }
+};
+
+template<typename Stage, typename... Rest> class FilterPipeline<Stage, Rest...> {
+ public:
+  explicit FilterPipeline(Stage stage, Rest... rest) : stage_(stage), rest_(rest...) {}
+  bool apply(float &value) { return this->stage_.apply(value) && this->rest_.apply(value); }
+
+ protected:
+  Stage stage_;
+  FilterPipeline<Rest...> rest_;
+};
+
+/** A run of simple filters fused into a single filter.
+ *
+ * The code generator emits this for consecutive offset, multiply, calibrate_linear, delta and throttle filters, so
+ * the whole run costs one virtual call per value instead of one per filter.
+ */
+template<typename... Stages> class FusedFilter : public Filter {
+ public:
+  explicit FusedFilter(Stages... stages) : pipeline_(stages...) {}
+
+  optional<float> new_value(float value) override {
+    if (!this->pipeline_.apply(value))
+      return {};
+    return value;
+  }
+
+  size_t new_values(const float *values, size_t count, float *out) override {
+    size_t out_count = 0;
+    for (size_t i = 0; i < count; i++) {
+      float value = values[i];
+      if (this->pipeline_.apply(value))
+        out[out_count++] = value;
+    }
+    return out_count;
+  }
+
+ protected:
+  FilterPipeline<Stages...> pipeline_;
+};
+
+/** Sliding window of the most recent values that keeps the non-NaN ones partially ordered.
+ *
+ * The values are split into two indexed heaps (the lower values in a max-heap, the upper values in a min-heap), so
+ * adding a value, evicting the oldest one and querying an order statistic all take O(log n). All storage is
+ * allocated when the capacity is set, there are no allocations per value. Slots are indexed with 16 bits, so the
+ * window holds at most MAX_CAPACITY values.
+ */
+class SortedWindow {
+ public:
+  static const size_t MAX_CAPACITY = UINT16_MAX;
+
+  explicit SortedWindow(size_t capacity);
+
+  /// Set the number of values kept in the window (at most MAX_CAPACITY), this clears the window.
+  void set_capacity(size_t capacity);
+  /// Add a value, evicting the oldest one if the window is full. NaN values take up a slot but are not ordered.
+  void push(float value);
+  /// Number of non-NaN values in the window.
+  size_t count() const { return this->lower_.size() + this->upper_.size(); }
+  /// Move values between the heaps so the lower heap holds exactly the lower_count smallest values.
+  void partition(size_t lower_count);
+  /// The largest value of the lower partition, the lower partition must not be empty.
+  float lower_max() const { return this->values_[this->lower_.front()]; }
+  /// The smallest value of the upper partition, the upper partition must not be empty.
+  float upper_min() const { return this->values_[this->upper_.front()]; }
+
+ protected:
+  enum HeapId : uint8_t { HEAP_NONE, HEAP_LOWER, HEAP_UPPER };
+
+  bool above_(HeapId heap, uint16_t a, uint16_t b) const;
+  void set_(HeapId heap, uint16_t pos, uint16_t slot);
+  void sift_up_(HeapId heap, uint16_t pos);
+  void sift_down_(HeapId heap, uint16_t pos);
+  void heap_push_(HeapId heap, uint16_t slot);
+  void heap_erase_(uint16_t slot);
+  std::vector<uint16_t> &heap_(HeapId heap) { return heap == HEAP_LOWER ? this->lower_ : this->upper_; }
+
+  std::vector<float> values_;       ///< ring of the values in the window
+  std::vector<uint8_t> heap_of_;    ///< heap each ring slot is in
+  std::vector<uint16_t> heap_pos_;  ///< position of each ring slot in its heap
+  std::vector<uint16_t> lower_;     ///< max-heap of ring slots
+  std::vector<uint16_t> upper_;     ///< min-heap of ring slots
+  uint16_t head_{0};                ///< slot of the oldest value
+  uint16_t size_{0};
+};
+
+/** Sliding window that tracks the minimum or maximum of its non-NaN values.
+ *
+ * Only the values that can still become the extremum are kept, in a monotonic queue ordered by age, so pushing a
+ * value is amortized O(1) and the extremum is always at the front. The queue is allocated when the capacity is set.
+ */
+class MonotonicWindow {
+ public:
+  MonotonicWindow(size_t capacity, bool maximum);
+
+  /// Set the number of values kept in the window, this clears the window.
+  void set_capacity(size_t capacity);
+  /// Add a value, evicting the oldest one if the window is full.
+  void push(float value);
+  /// The minimum or maximum value in the window, NaN if there are no non-NaN values.
+  float get() const;
+
+ protected:
+  struct Entry {
+    uint32_t seq;
+    float value;
+  };
+
+  Entry &at_(size_t index) { return this->queue_[(this->head_ + index) % this->queue_.size()]; }
+
+  std::vector<Entry> queue_;
+  size_t head_{0};
+  size_t size_{0};
+  uint32_t written_{0};  ///< sequence number of the next value
+  bool maximum_;
+};
+
 /** Simple quantile filter.
  *
  * Takes the quantile of the last <send_every> values and pushes it out every <send_every>.
@@ -67,10 +262,9 @@ class QuantileFilter : public Filter {
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  SortedWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
   float quantile_;
 };
 
@@ -96,10 +290,9 @@ class MedianFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SortedWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple skip filter.
@@ -137,15 +330,15 @@ class MinFilter : public Filter {
   explicit MinFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t new_values(const float *values, size_t count, float *out) override;
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  MonotonicWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple max filter.
@@ -165,15 +358,15 @@ class MaxFilter : public Filter {
   explicit MaxFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t new_values(const float *values, size_t count, float *out) override;
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  MonotonicWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
@@ -194,15 +387,24 @@ class SlidingWindowMovingAverageFilter : public Filter {
   explicit SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t new_values(const float *values, size_t count, float *out) override;
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  void add_(float value);
+  void push_(float value);
+  float average_() const;
+
+  std::vector<float> values_;  ///< ring of the values in the window
+  size_t head_{0};             ///< slot of the oldest value
+  size_t size_{0};
+  size_t nan_count_{0};        ///< number of NaN values in the window
+  float sum_{0.0f};            ///< sum of the non-NaN values in the window
+  float compensation_{0.0f};   ///< running compensation for the low-order bits lost from sum_
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple exponential moving average filter.
@@ -309,8 +511,7 @@ class ThrottleFilter : public Filter {
   optional<float> new_value(float value) override;
 
  protected:
-  uint32_t last_input_{0};
-  uint32_t min_time_between_inputs_;
+  ThrottleFilterStage stage_;
 };
 
 class DebounceFilter : public Filter, public Component {
@@ -348,10 +549,7 @@ class DeltaFilter : public Filter {
   optional<float> new_value(float value) override;
 
  protected:
-  float delta_;
-  float current_delta_;
-  bool percentage_mode_;
-  float last_value_{NAN};
+  DeltaFilterStage stage_;
 };
 
 class OrFilter : public Filter {
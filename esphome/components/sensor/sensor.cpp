@@ -1,4 +1,5 @@
 #include "sensor.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -36,18 +37,48 @@ StateClass Sensor::get_state_class() {
   return StateClass::STATE_CLASS_NONE;
 }
 
-void Sensor::publish_state(float state) {
+void Sensor::publish_state(float state) { this->publish_state(state, millis()); }
+void Sensor::publish_state(float state, uint32_t timestamp) {
   this->raw_state = state;
+  this->raw_state_timestamp_ = timestamp;
   this->raw_callback_.call(state);
 
   ESP_LOGV(TAG, "'%s': Received new state %f", this->name_.c_str(), state);
 
   if (this->filter_list_ == nullptr) {
-    this->internal_send_state_to_frontend(state);
+    this->internal_send_state_to_frontend(state, timestamp);
   } else {
-    this->filter_list_->input(state);
+    this->filter_list_->input(state, timestamp);
   }
 }
+void Sensor::publish_batch(const float *states, size_t count) { this->publish_batch(states, count, millis()); }
+void Sensor::publish_batch(const float *states, size_t count, uint32_t timestamp) {
+  if (count == 0)
+    return;
+  this->raw_state = states[count - 1];
+  this->raw_state_timestamp_ = timestamp;
+  this->raw_callback_.call(this->raw_state);
+
+  ESP_LOGV(TAG, "'%s': Received %zu new states", this->name_.c_str(), count);
+
+  if (this->filter_list_ == nullptr) {
+    this->internal_send_state_to_frontend(this->raw_state, timestamp);
+    return;
+  }
+  this->has_batch_state_ = false;
+  this->batching_ = true;
+  this->filter_list_->input_batch(states, count, timestamp);
+  this->batching_ = false;
+  if (this->has_batch_state_) {
+    this->has_batch_state_ = false;
+    this->internal_send_state_to_frontend(this->batch_state_, this->batch_state_timestamp_);
+  }
+}
+void Sensor::batch_output_(float state, uint32_t timestamp) {
+  this->batch_state_ = state;
+  this->batch_state_timestamp_ = timestamp;
+  this->has_batch_state_ = true;
+}
 
 void Sensor::add_on_state_callback(std::function<void(float)> &&callback) { this->callback_.add(std::move(callback)); }
 void Sensor::add_on_raw_state_callback(std::function<void(float)> &&callback) {
@@ -87,9 +118,11 @@ float Sensor::get_state() const { return this->state; }
 float Sensor::get_raw_state() const { return this->raw_state; }
 std::string Sensor::unique_id() { return ""; }
 
-void Sensor::internal_send_state_to_frontend(float state) {
+void Sensor::internal_send_state_to_frontend(float state) { this->internal_send_state_to_frontend(state, millis()); }
+void Sensor::internal_send_state_to_frontend(float state, uint32_t timestamp) {
   this->has_state_ = true;
   this->state = state;
+  this->state_timestamp_ = timestamp;
   ESP_LOGD(TAG, "'%s': Sending state %.5f %s with %d decimals of accuracy", this->get_name().c_str(), state,
            this->get_unit_of_measurement().c_str(), this->get_accuracy_decimals());
   this->callback_.call(state);
@@ -104,6 +104,10 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
   float get_state() const;
   /// Getter-syntax for .raw_state
   float get_raw_state() const;
+  /// The millis() at which the sample behind .state was captured.
+  uint32_t get_state_timestamp() const { return this->state_timestamp_; }
+  /// The millis() at which .raw_state was captured.
+  uint32_t get_raw_state_timestamp() const { return this->raw_state_timestamp_; }
 
   /** Publish a new state to the front-end.
    *
@@ -114,6 +118,29 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
    */
   void publish_state(float state);
 
+  /** Publish a new state that was captured earlier.
+   *
+   * Like publish_state(float), but the state keeps the time it was sampled at instead of the time it was published,
+   * so consumers like integrations and the API see when the value was actually measured.
+   *
+   * @param state The state as a floating point number.
+   * @param timestamp The millis() at which the state was captured.
+   */
+  void publish_state(float state, uint32_t timestamp);
+
+  /** Publish a block of new states, for sources that sample faster than states should be sent out.
+   *
+   * The block is passed through the filters as a whole. The raw callbacks are called once with the last raw
+   * state, and only the last value that comes out of the filter chain is sent to the front-end, so a block
+   * triggers at most one update.
+   *
+   * @param states The states as floating point numbers, oldest first.
+   * @param count The number of states.
+   */
+  void publish_batch(const float *states, size_t count);
+  /// Publish a block of new states, the last of which was captured at timestamp (in millis()).
+  void publish_batch(const float *states, size_t count, uint32_t timestamp);
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Add a callback that will be called every time a filtered value arrives.
@@ -146,8 +173,15 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
   virtual std::string unique_id();
 
   void internal_send_state_to_frontend(float state);
+  /// Send a state that belongs to the sample captured at timestamp (in millis()) to the front-end.
+  void internal_send_state_to_frontend(float state, uint32_t timestamp);
 
  protected:
+  friend Filter;
+
+  /// Remember the last value that came out of the filter chain while a batch is being published.
+  void batch_output_(float state, uint32_t timestamp);
+
   CallbackManager<void(float)> raw_callback_;  ///< Storage for raw state callbacks.
   CallbackManager<void(float)> callback_;      ///< Storage for filtered state callbacks.
 
@@ -157,6 +191,12 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
   optional<StateClass> state_class_{STATE_CLASS_NONE};  ///< State class override
   bool force_update_{false};                            ///< Force update mode
   bool has_state_{false};
+  bool has_batch_state_{false};
+  float batch_state_{NAN};
+  uint32_t batch_state_timestamp_{0};
+  bool batching_{false};             ///< Whether a batch is running through the filter chain
+  uint32_t raw_state_timestamp_{0};  ///< Capture time of raw_state
+  uint32_t state_timestamp_{0};      ///< Capture time of the sample behind state
 };
 
 }  // namespace sensor
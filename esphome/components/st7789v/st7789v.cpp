@@ -205,14 +205,12 @@ void ST7789V::write_display_data() {
   this->dc_pin_->digital_write(true);
 
   if (this->eightbitcolor_) {
-    for (int line = 0; line < this->get_buffer_length_(); line = line + this->get_width_internal()) {
-      for (int index = 0; index < this->get_width_internal(); ++index) {
-        auto color = display::ColorUtil::color_to_565(
-            display::ColorUtil::to_color(this->buffer_[index + line], display::ColorOrder::COLOR_ORDER_RGB,
-                                         display::ColorBitness::COLOR_BITNESS_332, true));
-        this->write_byte((color >> 8) & 0xff);
-        this->write_byte(color & 0xff);
-      }
+    uint8_t transfer_buffer[64 * 2];
+    const size_t buffer_length = this->get_buffer_length_();
+    for (size_t pos = 0; pos < buffer_length; pos += 64) {
+      const size_t count = std::min<size_t>(64, buffer_length - pos);
+      display::ColorUtil::rgb332_to_565_be(this->buffer_ + pos, transfer_buffer, count);
+      this->write_array(transfer_buffer, count * 2);
     }
   } else {
     this->write_array(this->buffer_, this->get_buffer_length_());
@@ -50,10 +50,13 @@ void TotalDailyEnergy::publish_state_and_save(float state) {
 void TotalDailyEnergy::process_new_state_(float state) {
   if (std::isnan(state))
     return;
-  const uint32_t now = millis();
+  // integrate over the time the samples were captured, not when they reached us
+  const uint32_t now = this->parent_->get_state_timestamp();
   const float old_state = this->last_power_state_;
   const float new_state = state;
-  float delta_hours = (now - this->last_update_) / 1000.0f / 60.0f / 60.0f;
+  // a sample captured before the previous update (e.g. before setup) adds no energy
+  const uint32_t dt_ms = int32_t(now - this->last_update_) > 0 ? now - this->last_update_ : 0;
+  float delta_hours = dt_ms / 1000.0f / 60.0f / 60.0f;
   float delta_energy = 0.0f;
   switch (this->method_) {
     case TOTAL_DAILY_ENERGY_METHOD_TRAPEZOID:
@@ -67,7 +70,8 @@ void TotalDailyEnergy::process_new_state_(float state) {
       break;
   }
   this->last_power_state_ = new_state;
-  this->last_update_ = now;
+  if (dt_ms > 0)
+    this->last_update_ = now;
   this->publish_state_and_save(this->total_energy_ + delta_energy);
 }
 
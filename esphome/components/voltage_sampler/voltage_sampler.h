@@ -2,14 +2,37 @@
 
 #include "esphome/core/component.h"
 
+#include <functional>
+
 namespace esphome {
 namespace voltage_sampler {
 
+/// Receives a block of voltage readings, in V, taken at a fixed rate.
+using SampleBlockCallback = std::function<void(const float *samples, size_t count)>;
+
 /// Abstract interface for components to request voltage (usually ADC readings)
 class VoltageSampler {
  public:
   /// Get a voltage reading, in V.
   virtual float sample() = 0;
+
+  /** Start sampling continuously in the background at a fixed rate.
+   *
+   * The samples are buffered by the hardware and handed to the callback in blocks from the main loop, so the caller
+   * doesn't need to request a high frequency loop. Only one consumer can sample continuously at a time.
+   *
+   * @param sample_rate The requested sample rate in Hz, the sampler may clamp it to what the hardware supports.
+   * @param callback Called with every block of samples until stop_continuous() is called.
+   * @return Whether continuous sampling was started, if not the caller should fall back to sample().
+   */
+  virtual bool start_continuous(uint32_t sample_rate, SampleBlockCallback &&callback) { return false; }
+  /// Whether start_continuous() is supported by this sampler at all.
+  virtual bool supports_continuous() const { return false; }
+  /// Stop sampling continuously, sample() can be used again afterwards.
+  virtual void stop_continuous() {}
+  /// Whether a consumer is sampling this source, or the hardware it shares, continuously. sample() must not be used
+  /// until it stops.
+  virtual bool is_continuous() const { return false; }
 };
 
 }  // namespace voltage_sampler
@@ -44,7 +44,7 @@ void write_row(AsyncResponseStream *stream, EntityBase *obj, const std::string &
   stream->print("\" id=\"");
   stream->print(klass.c_str());
   stream->print("-");
-  stream->print(obj->get_object_id().c_str());
+  stream->print(obj->get_object_id_ref().c_str());
   stream->print("\"><td>");
   stream->print(obj->get_name().c_str());
   stream->print("</td><td></td><td>");
@@ -368,7 +368,7 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 #define set_json_icon_state_value(root, obj, sensor, state, value, start_config) \
   set_json_value(root, obj, sensor, value, start_config)(root)["state"] = state; \
   if (((start_config) == DETAIL_ALL)) \
-    (root)["icon"] = (obj)->get_icon();
+    (root)["icon"] = (obj)->get_icon_ref();
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
@@ -376,7 +376,7 @@ void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (sensor::Sensor *obj : App.get_sensors()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     std::string data = this->sensor_json(obj, obj->state, DETAIL_STATE);
     request->send(200, "application/json", data.c_str());
@@ -391,10 +391,12 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
       state = "NA";
     } else {
       state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
-      if (!obj->get_unit_of_measurement().empty())
-        state += " " + obj->get_unit_of_measurement();
+      if (!obj->get_unit_of_measurement_ref().empty()) {
+        state += ' ';
+        state += obj->get_unit_of_measurement_ref();
+      }
     }
-    set_json_icon_state_value(root, obj, "sensor-" + obj->get_object_id(), state, value, start_config);
+    set_json_icon_state_value(root, obj, "sensor-" + obj->get_object_id_ref(), state, value, start_config);
   });
 }
 #endif
@@ -405,7 +407,7 @@ void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::s
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     std::string data = this->text_sensor_json(obj, obj->state, DETAIL_STATE);
     request->send(200, "application/json", data.c_str());
@@ -416,7 +418,7 @@ void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
                                         JsonDetail start_config) {
   return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
+    set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id_ref(), value, value, start_config);
   });
 }
 #endif
@@ -427,7 +429,8 @@ void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
   return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
+    set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id_ref(), value ? "ON" : "OFF", value,
+                              start_config);
     if (start_config == DETAIL_ALL) {
       root["assumed_state"] = obj->assumed_state();
     }
@@ -435,7 +438,7 @@ std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (switch_::Switch *obj : App.get_switches()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET) {
@@ -461,13 +464,14 @@ void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlM
 
 #ifdef USE_BUTTON
 std::string WebServer::button_json(button::Button *obj, JsonDetail start_config) {
-  return json::build_json(
-      [obj, start_config](JsonObject root) { set_json_id(root, obj, "button-" + obj->get_object_id(), start_config); });
+  return json::build_json([obj, start_config](JsonObject root) {
+    set_json_id(root, obj, "button-" + obj->get_object_id_ref(), start_config);
+  });
 }
 
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (button::Button *obj : App.get_buttons()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     if (request->method() == HTTP_POST && match.method == "press") {
       this->schedule_([obj]() { obj->press(); });
@@ -488,12 +492,13 @@ void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool s
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
   return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
+    set_json_state_value(root, obj, "binary_sensor-" + obj->get_object_id_ref(), value ? "ON" : "OFF", value,
+                         start_config);
   });
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     std::string data = this->binary_sensor_json(obj, obj->state, DETAIL_STATE);
     request->send(200, "application/json", data.c_str());
@@ -507,7 +512,8 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
 void WebServer::on_fan_update(fan::Fan *obj) { this->events_.send(this->fan_json(obj, DETAIL_STATE).c_str(), "state"); }
 std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
   return json::build_json([obj, start_config](JsonObject root) {
-    set_json_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state, start_config);
+    set_json_state_value(root, obj, "fan-" + obj->get_object_id_ref(), obj->state ? "ON" : "OFF", obj->state,
+                         start_config);
     const auto traits = obj->get_traits();
     if (traits.supports_speed()) {
       root["speed_level"] = obj->speed;
@@ -519,7 +525,7 @@ std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (fan::Fan *obj : App.get_fans()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET) {
@@ -580,7 +586,7 @@ void WebServer::on_light_update(light::LightState *obj) {
 }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (light::LightState *obj : App.get_lights()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET) {
@@ -638,7 +644,7 @@ void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMa
 }
 std::string WebServer::light_json(light::LightState *obj, JsonDetail start_config) {
   return json::build_json([obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "light-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "light-" + obj->get_object_id_ref(), start_config);
     root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
 
     light::LightJSONSchema::dump_json(*obj, root);
@@ -659,7 +665,7 @@ void WebServer::on_cover_update(cover::Cover *obj) {
 }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (cover::Cover *obj : App.get_covers()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET) {
@@ -700,7 +706,7 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMa
 }
 std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
   return json::build_json([obj, start_config](JsonObject root) {
-    set_json_state_value(root, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
+    set_json_state_value(root, obj, "cover-" + obj->get_object_id_ref(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
                          obj->position, start_config);
     root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
 
@@ -716,7 +722,7 @@ void WebServer::on_number_update(number::Number *obj, float state) {
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_numbers()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET) {
@@ -746,7 +752,7 @@ void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlM
 
 std::string WebServer::number_json(number::Number *obj, float value, JsonDetail start_config) {
   return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_id(root, obj, "number-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "number-" + obj->get_object_id_ref(), start_config);
     if (start_config == DETAIL_ALL) {
       root["min_value"] = obj->traits.get_min_value();
       root["max_value"] = obj->traits.get_max_value();
@@ -773,7 +779,7 @@ void WebServer::on_select_update(select::Select *obj, const std::string &state,
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_selects()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET) {
@@ -802,7 +808,7 @@ void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlM
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value, JsonDetail start_config) {
   return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_state_value(root, obj, "select-" + obj->get_object_id(), value, value, start_config);
+    set_json_state_value(root, obj, "select-" + obj->get_object_id_ref(), value, value, start_config);
     if (start_config == DETAIL_ALL) {
       JsonArray opt = root.createNestedArray("option");
       for (auto &option : obj->traits.get_options()) {
@@ -820,7 +826,7 @@ void WebServer::on_climate_update(climate::Climate *obj) {
 
 void WebServer::handle_climate_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_climates()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET) {
@@ -874,7 +880,7 @@ void WebServer::handle_climate_request(AsyncWebServerRequest *request, const Url
 
 std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_config) {
   return json::build_json([obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "climate-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "climate-" + obj->get_object_id_ref(), start_config);
     const auto traits = obj->get_traits();
     int8_t target_accuracy = traits.get_target_temperature_accuracy_decimals();
     int8_t current_accuracy = traits.get_current_temperature_accuracy_decimals();
@@ -966,13 +972,13 @@ void WebServer::on_lock_update(lock::Lock *obj) {
 }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config) {
   return json::build_json([obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
+    set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id_ref(), lock::lock_state_to_string(value), value,
                               start_config);
   });
 }
 void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (lock::Lock *obj : App.get_locks()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET) {
@@ -73,6 +73,9 @@ bool report_xiaomi_results(const optional<XiaomiParseResult> &result, const std:
 
 class XiaomiListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  std::vector<esp32_ble_tracker::ESPBTUUID> get_service_uuid_filter() const override {
+    return {esp32_ble_tracker::ESPBTUUID::from_uint16(0xFE95)};
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
@@ -19,6 +19,7 @@ class XiaomiCGPR1 : public Component,
   void set_bindkey(const std::string &bindkey);
 
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
+  std::vector<uint64_t> get_address_filter() const override { return {this->address_}; }
 
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
@@ -15,6 +15,7 @@ class XiaomiHHCCJCY01 : public Component, public esp32_ble_tracker::ESPBTDeviceL
   void set_address(uint64_t address) { address_ = address; }
 
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
+  std::vector<uint64_t> get_address_filter() const override { return {this->address_}; }
 
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
@@ -320,6 +320,25 @@ async def _add_platformio_options(pio_options):
         cg.add_platformio_option(key, val)
 
 
+@coroutine_with_priority(-1000.0)
+async def _add_callback_pool():
+    # Runs after all variables are declared. Size the callback pool for one callback per
+    # entity and controller plus one per trigger, anything beyond that goes on the heap.
+    controllers = sum(
+        1 for domain in ("api", "mqtt", "web_server") if domain in CORE.config
+    )
+    entities = 0
+    triggers = 0
+    for id_ in CORE.variables:
+        if not isinstance(id_.type, cg.MockObjClass):
+            continue
+        if id_.type.inherits_from(cg.EntityBase):
+            entities += 1
+        elif id_.type.inherits_from(automation.Trigger):
+            triggers += 1
+    cg.add_define("ESPHOME_CALLBACK_POOL_SIZE", entities * controllers + triggers)
+
+
 @coroutine_with_priority(30.0)
 async def _add_automations(config):
     for conf in config.get(CONF_ON_BOOT, []):
@@ -357,6 +376,7 @@ async def to_code(config):
     )
 
     CORE.add_job(_add_automations, config)
+    CORE.add_job(_add_callback_pool)
 
     cg.add_build_flag("-fno-exceptions")
 
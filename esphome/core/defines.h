@@ -13,6 +13,9 @@
 #define ESPHOME_PROJECT_VERSION "v2"
 #define ESPHOME_VARIANT "ESP32"
 
+// Sizes generated from the configuration
+#define ESPHOME_CALLBACK_POOL_SIZE 64
+
 // Feature flags
 #define USE_API
 #define USE_API_NOISE
@@ -29,6 +32,9 @@
 #define USE_LIGHT
 #define USE_LOCK
 #define USE_LOGGER
+#define USE_LOGGER_ASYNC
+#define USE_LOGGER_BINARY
+#define USE_LOGGER_TAG_LEVELS
 #define USE_MDNS
 #define USE_MEDIA_PLAYER
 #define USE_MQTT
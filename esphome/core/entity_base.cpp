@@ -2,6 +2,8 @@
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 
+#include <cstring>
+
 namespace esphome {
 
 static const char *const TAG = "entity_base";
@@ -27,12 +29,8 @@ bool EntityBase::is_disabled_by_default() const { return this->disabled_by_defau
 void EntityBase::set_disabled_by_default(bool disabled_by_default) { this->disabled_by_default_ = disabled_by_default; }
 
 // Entity Icon
-std::string EntityBase::get_icon() const {
-  if (this->icon_c_str_ == nullptr) {
-    return "";
-  }
-  return this->icon_c_str_;
-}
+std::string EntityBase::get_icon() const { return this->get_icon_ref().str(); }
+StringRef EntityBase::get_icon_ref() const { return StringRef::from_maybe_nullptr(this->icon_c_str_); }
 void EntityBase::set_icon(const char *icon) { this->icon_c_str_ = icon; }
 
 // Entity Category
@@ -40,54 +38,42 @@ EntityCategory EntityBase::get_entity_category() const { return this->entity_cat
 void EntityBase::set_entity_category(EntityCategory entity_category) { this->entity_category_ = entity_category; }
 
 // Entity Object ID
-std::string EntityBase::get_object_id() const {
-  // Check if `App.get_friendly_name()` is constant or dynamic.
-  if (!this->has_own_name_ && App.is_name_add_mac_suffix_enabled()) {
-    // `App.get_friendly_name()` is dynamic.
-    return str_sanitize(str_snake_case(App.get_friendly_name()));
-  } else {
-    // `App.get_friendly_name()` is constant.
-    if (this->object_id_c_str_ == nullptr) {
-      return "";
-    }
-    return this->object_id_c_str_;
-  }
-}
+std::string EntityBase::get_object_id() const { return this->get_object_id_ref().str(); }
+StringRef EntityBase::get_object_id_ref() const { return StringRef::from_maybe_nullptr(this->object_id_c_str_); }
 void EntityBase::set_object_id(const char *object_id) {
   this->object_id_c_str_ = object_id;
   this->calc_object_id_();
 }
 
-// Calculate Object ID Hash from Entity Name
+// Calculate Object ID and its Hash from Entity Name
 void EntityBase::calc_object_id_() {
   // Check if `App.get_friendly_name()` is constant or dynamic.
   if (!this->has_own_name_ && App.is_name_add_mac_suffix_enabled()) {
-    // `App.get_friendly_name()` is dynamic.
+    // `App.get_friendly_name()` is dynamic, but it is final by the time entities are set up,
+    // so compute the object id once and keep it for the lifetime of the entity.
     const auto object_id = str_sanitize(str_snake_case(App.get_friendly_name()));
-    // FNV-1 hash
-    this->object_id_hash_ = fnv1_hash(object_id);
-  } else {
-    // `App.get_friendly_name()` is constant.
-    // FNV-1 hash
-    this->object_id_hash_ = fnv1_hash(this->object_id_c_str_);
+    char *object_id_c_str = new char[object_id.size() + 1];  // NOLINT(cppcoreguidelines-owning-memory)
+    memcpy(object_id_c_str, object_id.c_str(), object_id.size() + 1);
+    this->object_id_c_str_ = object_id_c_str;
   }
+  // FNV-1 hash
+  this->object_id_hash_ = fnv1_hash(this->get_object_id_ref().str());
 }
 
 uint32_t EntityBase::get_object_id_hash() { return this->object_id_hash_; }
 
-std::string EntityBase_DeviceClass::get_device_class() {
-  if (this->device_class_ == nullptr) {
-    return "";
-  }
-  return this->device_class_;
+std::string EntityBase_DeviceClass::get_device_class() { return this->get_device_class_ref().str(); }
+StringRef EntityBase_DeviceClass::get_device_class_ref() const {
+  return StringRef::from_maybe_nullptr(this->device_class_);
 }
 
 void EntityBase_DeviceClass::set_device_class(const char *device_class) { this->device_class_ = device_class; }
 
 std::string EntityBase_UnitOfMeasurement::get_unit_of_measurement() {
-  if (this->unit_of_measurement_ == nullptr)
-    return "";
-  return this->unit_of_measurement_;
+  return this->get_unit_of_measurement_ref().str();
+}
+StringRef EntityBase_UnitOfMeasurement::get_unit_of_measurement_ref() const {
+  return StringRef::from_maybe_nullptr(this->unit_of_measurement_);
 }
 void EntityBase_UnitOfMeasurement::set_unit_of_measurement(const char *unit_of_measurement) {
   this->unit_of_measurement_ = unit_of_measurement;
@@ -24,6 +24,8 @@ class EntityBase {
 
   // Get the sanitized name of this Entity as an ID.
   std::string get_object_id() const;
+  // Get the sanitized name of this Entity as an ID, without copying it.
+  StringRef get_object_id_ref() const;
   void set_object_id(const char *object_id);
 
   // Get the unique Object ID of this Entity
@@ -45,6 +47,7 @@ class EntityBase {
 
   // Get/set this entity's icon
   std::string get_icon() const;
+  StringRef get_icon_ref() const;
   void set_icon(const char *icon);
 
  protected:
@@ -67,6 +70,8 @@ class EntityBase_DeviceClass {
  public:
   /// Get the device class, using the manual override if set.
   std::string get_device_class();
+  /// Get the device class without copying it.
+  StringRef get_device_class_ref() const;
   /// Manually set the device class.
   void set_device_class(const char *device_class);
 
@@ -78,6 +83,8 @@ class EntityBase_UnitOfMeasurement {
  public:
   /// Get the unit of measurement, using the manual override if set.
   std::string get_unit_of_measurement();
+  /// Get the unit of measurement without copying it.
+  StringRef get_unit_of_measurement_ref() const;
   /// Manually set the unit of measurement.
   void set_unit_of_measurement(const char *unit_of_measurement);
 
@@ -8,6 +8,7 @@
 #include <cctype>
 #include <cmath>
 #include <cstdarg>
+#include <cstddef>
 #include <cstdio>
 #include <cstring>
 
@@ -419,7 +420,7 @@ void hsv_to_rgb(int hue, float saturation, float value, float &red, float &green
 }
 
 // System APIs
-#if defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_HOST)
+#if defined(USE_ESP8266) || defined(USE_RP2040)
 // ESP8266 doesn't have mutexes, but that shouldn't be an issue as it's single-core and non-preemptive OS.
 Mutex::Mutex() {}
 void Mutex::lock() {}
@@ -430,6 +431,11 @@ Mutex::Mutex() { handle_ = xSemaphoreCreateMutex(); }
 void Mutex::lock() { xSemaphoreTake(this->handle_, portMAX_DELAY); }
 bool Mutex::try_lock() { return xSemaphoreTake(this->handle_, 0) == pdTRUE; }
 void Mutex::unlock() { xSemaphoreGive(this->handle_); }
+#elif defined(USE_HOST)
+Mutex::Mutex() {}
+void Mutex::lock() { this->mutex_.lock(); }
+bool Mutex::try_lock() { return this->mutex_.try_lock(); }
+void Mutex::unlock() { this->mutex_.unlock(); }
 #endif
 
 #if defined(USE_ESP8266)
@@ -445,6 +451,36 @@ IRAM_ATTR InterruptLock::InterruptLock() { state_ = save_and_disable_interrupts(
 IRAM_ATTR InterruptLock::~InterruptLock() { restore_interrupts(state_); }
 #endif
 
+#ifndef ESPHOME_CALLBACK_POOL_SIZE
+#define ESPHOME_CALLBACK_POOL_SIZE 0
+#endif
+// Size of a callback node, a std::function and the pointer to the next node
+static const size_t CALLBACK_POOL_NODE_SIZE =
+    (sizeof(std::function<void()>) + sizeof(void *) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+static const size_t CALLBACK_POOL_BYTES = ESPHOME_CALLBACK_POOL_SIZE * CALLBACK_POOL_NODE_SIZE;
+#if ESPHOME_CALLBACK_POOL_SIZE > 0
+alignas(std::max_align_t) static uint8_t callback_pool[CALLBACK_POOL_BYTES];  // NOLINT
+#else
+static uint8_t *const callback_pool = nullptr;
+#endif
+static size_t callback_pool_used = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void *callback_pool_allocate(size_t size) {
+  size = (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+  if (CALLBACK_POOL_BYTES - callback_pool_used >= size) {
+    void *ptr = callback_pool + callback_pool_used;
+    callback_pool_used += size;
+    return ptr;
+  }
+  return ::operator new(size);  // NOLINT(cppcoreguidelines-owning-memory)
+}
+void callback_pool_free(void *ptr) {
+  auto *bytes = static_cast<uint8_t *>(ptr);
+  if (bytes >= callback_pool && bytes < callback_pool + CALLBACK_POOL_BYTES)
+    return;
+  ::operator delete(ptr);  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
 uint8_t HighFrequencyLoopRequester::num_requests = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 void HighFrequencyLoopRequester::start() {
   if (this->started_)
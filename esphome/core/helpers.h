@@ -4,6 +4,7 @@
 #include <cstring>
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -19,6 +20,10 @@
 #include <freertos/semphr.h>
 #endif
 
+#ifdef USE_HOST
+#include <mutex>
+#endif
+
 #define HOT __attribute__((hot))
 #define ESPDEPRECATED(msg, when) __attribute__((deprecated(msg)))
 #define ALWAYS_INLINE __attribute__((always_inline))
@@ -459,28 +464,67 @@ constexpr float fahrenheit_to_celsius(float value) { return (value - 32.0f) / 1.
 /// @name Utilities
 /// @{
 
+/** Allocate storage for a callback.
+ *
+ * Callbacks are registered during setup and live as long as the application, so they are carved out of a single
+ * pool sized by the code generator (ESPHOME_CALLBACK_POOL_SIZE callbacks) instead of being allocated one by one,
+ * which keeps them from fragmenting the heap. When the pool is exhausted the heap is used.
+ */
+void *callback_pool_allocate(size_t size);
+/// Release storage returned by callback_pool_allocate(), memory from the pool is not reused.
+void callback_pool_free(void *ptr);
+
 template<typename... X> class CallbackManager;
 
 /** Helper class to allow having multiple subscribers to a callback.
+ *
+ * The callbacks are kept in a singly linked list of nodes from the callback pool, so an empty manager is a single
+ * pointer and adding a callback never reallocates.
  *
  * @tparam Ts The arguments for the callbacks, wrapped in void().
  */
 template<typename... Ts> class CallbackManager<void(Ts...)> {
  public:
+  CallbackManager() = default;
+  CallbackManager(const CallbackManager &) = delete;
+  CallbackManager &operator=(const CallbackManager &) = delete;
+  ~CallbackManager() {
+    while (this->first_ != nullptr) {
+      Node *next = this->first_->next;
+      this->first_->~Node();
+      callback_pool_free(this->first_);
+      this->first_ = next;
+    }
+  }
+
   /// Add a callback to the list.
-  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  void add(std::function<void(Ts...)> &&callback) {
+    Node *node = new (callback_pool_allocate(sizeof(Node))) Node{std::move(callback), nullptr};
+    Node **tail = &this->first_;
+    while (*tail != nullptr)
+      tail = &(*tail)->next;
+    *tail = node;
+  }
 
-  /// Call all callbacks in this manager.
-  void call(Ts... args) {
-    for (auto &cb : this->callbacks_)
-      cb(args...);
+  /// Call all callbacks in this manager, the arguments are passed on by reference so they aren't copied per callback.
+  template<typename... Args> void call(Args &&...args) {
+    for (Node *node = this->first_; node != nullptr; node = node->next)
+      node->callback(args...);
   }
 
   /// Call all callbacks in this manager.
-  void operator()(Ts... args) { call(args...); }
+  template<typename... Args> void operator()(Args &&...args) { call(args...); }
+
+  /// Check whether no callbacks were added to this manager.
+  bool empty() const { return this->first_ == nullptr; }
 
  protected:
-  std::vector<std::function<void(Ts...)>> callbacks_;
+  struct Node {
+    std::function<void(Ts...)> callback;
+    Node *next;
+  };
+
+  Node *first_{nullptr};
 };
 
 /// Helper class to deduplicate items in a series of values.
@@ -541,6 +585,8 @@ class Mutex {
  private:
 #if defined(USE_ESP32)
   SemaphoreHandle_t handle_;
+#elif defined(USE_HOST)
+  std::mutex mutex_;
 #endif
 };
 
@@ -46,6 +46,40 @@ void HOT esp_log_vprintf_(int level, const char *tag, int line, const __FlashStr
 }
 #endif
 
+#ifdef USE_LOGGER_TAG_LEVELS
+static inline bool HOT site_level_enabled(uint8_t &tag_level, int level, const char *tag) {
+  if (tag_level == ESPHOME_LOG_LEVEL_UNRESOLVED) {
+    // tag levels are final once the logger is set up, messages before that are dropped anyway
+    auto *log = logger::global_logger;
+    if (log == nullptr)
+      return false;
+    tag_level = log->level_for(tag);
+  }
+  return level <= tag_level;
+}
+
+void HOT esp_log_site_printf_(uint8_t &tag_level, int level, const char *tag, int line, const char *format,
+                              ...) {  // NOLINT
+  if (!site_level_enabled(tag_level, level, tag))
+    return;
+  va_list arg;
+  va_start(arg, format);
+  logger::global_logger->log_enabled_vprintf_(level, tag, line, format, arg);
+  va_end(arg);
+}
+#ifdef USE_STORE_LOG_STR_IN_FLASH
+void HOT esp_log_site_printf_(uint8_t &tag_level, int level, const char *tag, int line,
+                              const __FlashStringHelper *format, ...) {
+  if (!site_level_enabled(tag_level, level, tag))
+    return;
+  va_list arg;
+  va_start(arg, format);
+  logger::global_logger->log_enabled_vprintf_(level, tag, line, format, arg);
+  va_end(arg);
+}
+#endif
+#endif
+
 #if defined(USE_ESP32_FRAMEWORK_ARDUINO) || defined(USE_ESP_IDF)
 int HOT esp_idf_log_vprintf_(const char *format, va_list args) {  // NOLINT
 #ifdef USE_LOGGER
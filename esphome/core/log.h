@@ -2,11 +2,13 @@
 
 #include <cassert>
 #include <cstdarg>
+#include <cstdint>
 #include <string>
 
+#include "esphome/core/defines.h"
+
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 #include "WString.h"
-#include "esphome/core/defines.h"  // for USE_ARDUINO_VERSION_CODE
 #endif
 
 // Include ESP-IDF/Arduino based logging methods here so they don't undefine ours later
@@ -69,9 +71,38 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #define ESPHOME_LOG_FORMAT(format) format
 #endif
 
+#ifdef USE_LOGGER_TAG_LEVELS
+/// Level of a log statement whose tag wasn't looked up yet.
+#define ESPHOME_LOG_LEVEL_UNRESOLVED 0xFF
+
+void esp_log_site_printf_(uint8_t &tag_level, int level, const char *tag, int line, const char *format,  // NOLINT
+                          ...) __attribute__((format(printf, 5, 6)));
+#ifdef USE_STORE_LOG_STR_IN_FLASH
+void esp_log_site_printf_(uint8_t &tag_level, int level, const char *tag, int line,
+                          const __FlashStringHelper *format, ...);
+#endif
+
+// A log statement with a constant tag caches the level of that tag in one byte the first time it runs, so the per-tag
+// levels only have to be looked up once and discarding a message costs a single comparison. A byte is read and
+// written as a whole, so statements running on several tasks can't see a torn value. Statements that get their tag
+// passed in at runtime aren't cached and leave the check to the logger.
+#define esph_log_(level, tag, format, ...) \
+  ({ \
+    if (__builtin_constant_p(tag)) { \
+      static uint8_t esph_log_tag_level = ESPHOME_LOG_LEVEL_UNRESOLVED; \
+      if ((level) <= esph_log_tag_level) \
+        esp_log_site_printf_(esph_log_tag_level, level, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__); \
+    } else { \
+      esp_log_printf_(level, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__); \
+    } \
+  })
+#else
+#define esph_log_(level, tag, format, ...) \
+  esp_log_printf_(level, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#endif
+
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERY_VERBOSE
-#define esph_log_vv(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_vv(tag, format, ...) esph_log_(ESPHOME_LOG_LEVEL_VERY_VERBOSE, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_VERY_VERBOSE
 #else
@@ -79,8 +110,7 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
-#define esph_log_v(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_VERBOSE, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_v(tag, format, ...) esph_log_(ESPHOME_LOG_LEVEL_VERBOSE, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_VERBOSE
 #else
@@ -88,10 +118,8 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_DEBUG
-#define esph_log_d(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_DEBUG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
-#define esph_log_config(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_CONFIG, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_d(tag, format, ...) esph_log_(ESPHOME_LOG_LEVEL_DEBUG, tag, format, ##__VA_ARGS__)
+#define esph_log_config(tag, format, ...) esph_log_(ESPHOME_LOG_LEVEL_CONFIG, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_DEBUG
 #define ESPHOME_LOG_HAS_CONFIG
@@ -101,8 +129,7 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_INFO
-#define esph_log_i(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_INFO, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_i(tag, format, ...) esph_log_(ESPHOME_LOG_LEVEL_INFO, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_INFO
 #else
@@ -110,8 +137,7 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_WARN
-#define esph_log_w(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_WARN, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_w(tag, format, ...) esph_log_(ESPHOME_LOG_LEVEL_WARN, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_WARN
 #else
@@ -119,8 +145,7 @@ int esp_idf_log_vprintf_(const char *format, va_list args);  // NOLINT
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_ERROR
-#define esph_log_e(tag, format, ...) \
-  esp_log_printf_(ESPHOME_LOG_LEVEL_ERROR, tag, __LINE__, ESPHOME_LOG_FORMAT(format), ##__VA_ARGS__)
+#define esph_log_e(tag, format, ...) esph_log_(ESPHOME_LOG_LEVEL_ERROR, tag, format, ##__VA_ARGS__)
 
 #define ESPHOME_LOG_HAS_ERROR
 #else
@@ -0,0 +1,283 @@
+"""String table of the binary log format.
+
+With `binary_format` enabled, the logger sends API clients only the IDs of the
+format string and tag of a log message together with its packed printf
+arguments (see BinaryLogMessage in logger.h). The format strings and tags are
+collected from the sources at compile time into a table, which is what turns
+these messages back into text.
+"""
+import json
+import re
+import struct
+from pathlib import Path
+from typing import Iterable, Optional, Union
+
+# Length modifiers the <inttypes.h> format macros expand to. They follow the
+# types the toolchain picks for the fixed width integers: with newlib 32 bit
+# integers are longs, except for the Xtensa toolchains before ESP-IDF 5, where
+# they are ints.
+PRI_LENGTHS_NEWLIB = {"8": "hh", "16": "h", "32": "l", "64": "ll", "PTR": ""}
+PRI_LENGTHS_XTENSA = {"8": "hh", "16": "h", "32": "", "64": "ll", "PTR": ""}
+PRI_LENGTHS_GLIBC = {"8": "hh", "16": "h", "32": "", "64": "l", "PTR": "l"}
+
+_RISCV_ESP32_VARIANTS = ("ESP32C3", "ESP32H2")
+
+_STRING = r'"(?:[^"\\\n]|\\.)*"'
+_PRI = r"PRI[diouxX](?:8|16|32|64|PTR)"
+_LOG_CALL_RE = re.compile(
+    r"\b(?:ESP_LOG(?:VV|V|D|CONFIG|I|W|E)|esph_log_(?:vv|v|d|config|i|w|e))\s*\(\s*"
+    rf"(?P<tag>[A-Za-z_]\w*|{_STRING})\s*,\s*"
+    rf"(?P<format>(?:{_STRING}|{_PRI}|\s+)+?)\s*[,)]"
+)
+_TAG_RE = re.compile(rf"\bTAG\s*=\s*(?P<tag>{_STRING})\s*;")
+_FORMAT_PART_RE = re.compile(rf"{_STRING}|(?P<pri>PRI(?P<conv>[diouxX])(?P<bits>\w+))")
+_ESCAPE_RE = re.compile(r"\\(x[0-9a-fA-F]+|[0-7]{1,3}|.)", re.S)
+_SIMPLE_ESCAPES = {
+    "n": 10,
+    "t": 9,
+    "r": 13,
+    "a": 7,
+    "b": 8,
+    "f": 12,
+    "v": 11,
+    "e": 27,
+}
+_CONVERSION_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d*))?"
+    r"(?:hh|h|ll|l|L|j|z|t)?(?P<type>[diouxXeEfFgGaAcspn%])"
+)
+
+LOG_LEVEL_LETTERS = ["", "E", "W", "I", "C", "D", "V", "VV"]
+LOG_LEVEL_COLORS = [
+    "",
+    "\033[1;31m",
+    "\033[0;33m",
+    "\033[0;32m",
+    "\033[0;35m",
+    "\033[0;36m",
+    "\033[0;37m",
+    "\033[0;38m",
+]
+LOG_RESET_COLOR = "\033[0m"
+
+
+def pri_lengths_for(
+    platform: str,
+    framework: Optional[str] = None,
+    framework_version: Optional[tuple[int, ...]] = None,
+    variant: Optional[str] = None,
+) -> dict[str, str]:
+    """The length modifiers of the <inttypes.h> macros on a target."""
+    if platform == "host":
+        return PRI_LENGTHS_GLIBC
+    if platform == "esp8266":
+        return PRI_LENGTHS_XTENSA
+    if platform == "esp32":
+        if variant in _RISCV_ESP32_VARIANTS:
+            return PRI_LENGTHS_NEWLIB
+        # ESP-IDF 5 switched the Xtensa toolchain to 32 bit longs
+        if framework == "esp-idf" and (framework_version or (0,)) >= (5, 0, 0):
+            return PRI_LENGTHS_NEWLIB
+        return PRI_LENGTHS_XTENSA
+    return PRI_LENGTHS_NEWLIB
+
+
+def log_string_id(value: bytes) -> int:
+    """The ID of a format string or tag, the same FNV-1 hash the logger computes."""
+    hash_ = 2166136261
+    for byte in value:
+        hash_ = (hash_ * 16777619) & 0xFFFFFFFF
+        hash_ ^= byte
+    return hash_
+
+
+def _unescape(literal: str) -> bytes:
+    """Convert the contents of a C string literal to the bytes it stands for."""
+    result = bytearray()
+    pos = 0
+    for match in _ESCAPE_RE.finditer(literal):
+        result += literal[pos : match.start()].encode("utf-8")
+        escape = match.group(1)
+        if escape[0] == "x":
+            result.append(int(escape[1:], 16) & 0xFF)
+        elif escape[0] in "01234567":
+            result.append(int(escape, 8) & 0xFF)
+        elif escape in _SIMPLE_ESCAPES:
+            result.append(_SIMPLE_ESCAPES[escape])
+        else:
+            result += escape.encode("utf-8")
+        pos = match.end()
+    result += literal[pos:].encode("utf-8")
+    return bytes(result)
+
+
+def _parse_format(expression: str, pri_lengths: dict[str, str]) -> Optional[bytes]:
+    """Evaluate a concatenation of string literals and <inttypes.h> macros."""
+    result = b""
+    for match in _FORMAT_PART_RE.finditer(expression):
+        if match.group("pri") is None:
+            result += _unescape(match.group(0)[1:-1])
+            continue
+        length = pri_lengths.get(match.group("bits"))
+        if length is None:
+            return None
+        result += (length + match.group("conv")).encode("ascii")
+    return result
+
+
+class LogStringTable:
+    def __init__(self):
+        self.formats: dict[int, str] = {}
+        self.tags: dict[int, str] = {}
+
+    def add_format(self, value: Union[str, bytes]):
+        if isinstance(value, str):
+            value = value.encode("utf-8")
+        self.formats[log_string_id(value)] = value.decode("utf-8", "backslashreplace")
+
+    def add_tag(self, value: Union[str, bytes]):
+        if isinstance(value, str):
+            value = value.encode("utf-8")
+        self.tags[log_string_id(value)] = value.decode("utf-8", "backslashreplace")
+
+    def scan_source(self, text: str, pri_lengths: dict[str, str]):
+        """Add the format strings and tags of all log calls in a C++ source file."""
+        for match in _TAG_RE.finditer(text):
+            self.add_tag(_unescape(match.group("tag")[1:-1]))
+        for match in _LOG_CALL_RE.finditer(text):
+            tag = match.group("tag")
+            if tag.startswith('"'):
+                self.add_tag(_unescape(tag[1:-1]))
+            fmt = _parse_format(match.group("format"), pri_lengths)
+            if fmt is not None:
+                self.add_format(fmt)
+
+    def to_json(self) -> str:
+        return json.dumps(
+            {
+                "formats": {str(k): v for k, v in sorted(self.formats.items())},
+                "tags": {str(k): v for k, v in sorted(self.tags.items())},
+            },
+            indent=2,
+            sort_keys=True,
+        )
+
+    @classmethod
+    def load(cls, path: Union[str, Path]) -> "LogStringTable":
+        data = json.loads(Path(path).read_text(encoding="utf-8"))
+        table = cls()
+        table.formats = {int(k): v for k, v in data["formats"].items()}
+        table.tags = {int(k): v for k, v in data["tags"].items()}
+        return table
+
+    def format_message(
+        self, level: int, tag_id: int, format_id: int, line: int, args: bytes
+    ) -> str:
+        """Rebuild the line the device would have printed for a binary log message."""
+        if format_id == 0:
+            # sent as text
+            return args.decode("utf-8", "backslashreplace")
+        tag = self.tags.get(tag_id, f"{tag_id:08x}")
+        fmt = self.formats.get(format_id)
+        if fmt is None:
+            message = f"<unknown format {format_id:08x}>"
+        else:
+            message = decode_log_args(fmt, args).rstrip("\n")
+        level = min(max(level, 0), 7)
+        return (
+            f"{LOG_LEVEL_COLORS[level]}[{LOG_LEVEL_LETTERS[level]}][{tag}:{line:03}]: "
+            f"{message}{LOG_RESET_COLOR}"
+        )
+
+
+class _ArgsReader:
+    def __init__(self, data: bytes):
+        self._data = data
+        self._pos = 0
+
+    def unsigned(self) -> int:
+        result = 0
+        shift = 0
+        while True:
+            if self._pos >= len(self._data):
+                raise IndexError
+            byte = self._data[self._pos]
+            self._pos += 1
+            result |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return result
+
+    def signed(self) -> int:
+        value = self.unsigned()
+        return (value >> 1) ^ -(value & 1)
+
+    def double(self) -> float:
+        if self._pos + 8 > len(self._data):
+            raise IndexError
+        (value,) = struct.unpack_from("<d", self._data, self._pos)
+        self._pos += 8
+        return value
+
+    def string(self) -> str:
+        end = self._data.index(b"\0", self._pos)
+        value = self._data[self._pos : end]
+        self._pos = end + 1
+        return value.decode("utf-8", "backslashreplace")
+
+
+def decode_log_args(fmt: str, args: bytes) -> str:
+    """Apply printf format fmt to the arguments packed by the logger."""
+    reader = _ArgsReader(args)
+
+    def convert(match: re.Match) -> str:
+        type_ = match.group("type")
+        if type_ == "%":
+            return "%"
+        try:
+            width = match.group("width") or ""
+            if width == "*":
+                width = str(reader.signed())
+            precision = match.group("precision")
+            if precision == "*":
+                precision = str(reader.signed())
+            elif precision == "":
+                precision = "0"
+            if type_ in "di":
+                value = reader.signed()
+            elif type_ in "uoxX":
+                value = reader.unsigned()
+                if type_ == "u":
+                    type_ = "d"
+            elif type_ == "c":
+                value = reader.unsigned()
+            elif type_ == "p":
+                return f"0x{reader.unsigned():x}"
+            elif type_ == "n":
+                return ""
+            elif type_ in "aA":
+                value = reader.double().hex()
+                return value.upper() if type_ == "A" else value
+            elif type_ == "s":
+                value = reader.string()
+            else:
+                value = reader.double()
+        except (IndexError, ValueError):
+            return "<missing>"
+        spec = f"%{match.group('flags')}{width}"
+        if precision is not None:
+            spec += f".{precision}"
+        return (spec + type_) % value
+
+    return _CONVERSION_RE.sub(convert, fmt)
+
+
+def build_string_table(
+    sources: Iterable[str], pri_lengths: dict[str, str], extra_formats: Iterable[str]
+) -> LogStringTable:
+    table = LogStringTable()
+    for text in sources:
+        table.scan_source(text, pri_lengths)
+    for fmt in extra_formats:
+        table.add_format(fmt)
+    return table
@@ -0,0 +1,49 @@
+import pytest
+
+from esphome.components.image import rle_encode
+
+
+def rle_decode(data, width, height, frames, bytes_per_pixel):
+    """Decode every row on its own from its offset, like Image::draw_rle() does."""
+    result = []
+    for row in range(height * frames):
+        pos = int.from_bytes(bytes(data[row * 4 : row * 4 + 4]), "big")
+        x = 0
+        while x < width:
+            header = data[pos]
+            pos += 1
+            count = (header & 0x7F) + 1
+            if header & 0x80:
+                result += data[pos : pos + bytes_per_pixel] * count
+                pos += bytes_per_pixel
+            else:
+                result += data[pos : pos + count * bytes_per_pixel]
+                pos += count * bytes_per_pixel
+            x += count
+        assert x == width
+    return result
+
+
+@pytest.mark.parametrize(
+    "width, height, frames, bytes_per_pixel, pixels",
+    (
+        (1, 1, 1, 1, [7]),
+        (5, 2, 1, 1, [1, 1, 1, 1, 1, 2, 3, 4, 5, 6]),
+        (4, 2, 1, 2, [1, 2, 1, 2, 3, 4, 3, 4, 0, 0, 0, 0, 0, 0, 5, 6]),
+        (3, 1, 2, 3, [9, 9, 9] * 3 + [1, 2, 3, 4, 5, 6, 1, 2, 3]),
+        # runs and literals longer than one packet
+        (300, 1, 1, 1, [0] * 200 + list(range(100))),
+        (260, 2, 1, 1, [i % 256 for i in range(260)] + [4] * 130 + [5] * 130),
+    ),
+)
+def test_rle_round_trip(width, height, frames, bytes_per_pixel, pixels):
+    data = rle_encode(pixels, width, height, frames, bytes_per_pixel)
+
+    assert all(0 <= b <= 0xFF for b in data)
+    assert rle_decode(data, width, height, frames, bytes_per_pixel) == pixels
+
+
+def test_rle_encode_compresses_runs():
+    data = rle_encode([3] * 128 + [4] * 2, 130, 1, 1, 1)
+
+    assert data == [0, 0, 0, 4, 0xFF, 3, 0x81, 4]
@@ -0,0 +1,88 @@
+import struct
+
+import pytest
+
+from esphome import log_strings
+
+
+@pytest.mark.parametrize(
+    "value, expected",
+    (
+        (b"", 0x811C9DC5),
+        (b"a", 0x050C5D7E),
+        (b"foobar", 0x31F0B262),
+    ),
+)
+def test_log_string_id(value, expected):
+    assert log_strings.log_string_id(value) == expected
+
+
+def test_scan_source():
+    table = log_strings.LogStringTable()
+    table.scan_source(
+        'static const char *const TAG = "sensor";\n'
+        'ESP_LOGD(TAG, "Got %" PRIu32 " bytes\\n", len);\n'
+        'ESP_LOGW("other", "Plain");\n',
+        log_strings.PRI_LENGTHS_NEWLIB,
+    )
+
+    assert set(table.tags.values()) == {"sensor", "other"}
+    assert set(table.formats.values()) == {"Got %lu bytes\n", "Plain"}
+    assert table.formats[log_strings.log_string_id(b"Plain")] == "Plain"
+
+
+@pytest.mark.parametrize(
+    "target, expected",
+    (
+        (("host", "host"), "Got %u"),
+        (("esp8266", "arduino", (3, 0, 2)), "Got %u"),
+        (("esp32", "arduino", (2, 0, 5), "ESP32"), "Got %u"),
+        (("esp32", "esp-idf", (4, 4, 4), "ESP32"), "Got %u"),
+        (("esp32", "esp-idf", (4, 4, 4), "ESP32C3"), "Got %lu"),
+        (("esp32", "esp-idf", (5, 0, 1), "ESP32S3"), "Got %lu"),
+        (("rp2040", "arduino", (2, 6, 4)), "Got %lu"),
+    ),
+)
+def test_pri_lengths_for(target, expected):
+    table = log_strings.LogStringTable()
+    table.scan_source(
+        'ESP_LOGD("tag", "Got %" PRIu32, len);\n',
+        log_strings.pri_lengths_for(*target),
+    )
+
+    assert set(table.formats.values()) == {expected}
+
+
+def test_decode_log_args():
+    # -3 zigzag encoded, 300 as varint, a double and a string
+    args = bytes([5, 0xAC, 0x02]) + struct.pack("<d", 1.5) + b"abc\0"
+
+    actual = log_strings.decode_log_args("%d %u %.2f %s %%", args)
+
+    assert actual == "-3 300 1.50 abc %"
+
+
+def test_decode_log_args__missing():
+    assert log_strings.decode_log_args("%d %s", bytes([2])) == "1 <missing>"
+
+
+def test_format_message():
+    table = log_strings.LogStringTable()
+    table.add_tag("tag")
+    table.add_format("Value %d")
+
+    actual = table.format_message(
+        3,
+        log_strings.log_string_id(b"tag"),
+        log_strings.log_string_id(b"Value %d"),
+        12,
+        bytes([84]),
+    )
+
+    assert actual == "\033[0;32m[I][tag:012]: Value 42\033[0m"
+
+
+def test_format_message__text():
+    table = log_strings.LogStringTable()
+
+    assert table.format_message(3, 0, 0, 0, b"as text") == "as text"